@@ -0,0 +1,36 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file bench.h 
+ * @brief Benchmarks of the common modules.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stdint.h>
+
+/**
+ * @brief function to run the benchmarks
+ * 
+ * This function runs the benchmarks of the common modules and prints
+ * their timings. It is called from main() when the -DBENCH compile time
+ * switch is given. Sizes can be tuned with the BENCH_SAMPLES environment
+ * variable.
+ *
+ * @return void
+ */
+void bench(void);
+
+#endif /* __BENCH_H__ */
@@ -0,0 +1,155 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file clock.h
+ * @brief Runtime switching of the core clock and the power regulator
+ *
+ * clock_set() moves between the DCO frequencies of SystemInit() (1.5, 3,
+ * 12, 24 and 48 MHz) and between the LDO and DC-DC regulators while the
+ * program runs, e.g. up to 48 MHz for batch processing and back down when
+ * idle. The core voltage (VCORE) and the flash wait states must suit the
+ * clock at every moment, so the switch is a sequence of steps: going up,
+ * VCORE is raised and wait states are added before the DCO speeds up,
+ * going down, the DCO slows down first. VCORE only changes on the LDO, so
+ * a DC-DC switch to another VCORE passes through the LDO.
+ *
+ * Registered callbacks are called before and after every switch, so that
+ * the console can drain its queue and recompute the UART baud rate, and
+ * timers their periods.
+ *
+ * On HOST the steps only update a simulated state, which makes the
+ * sequencing testable.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __CLOCK_H__
+#define __CLOCK_H__
+
+#include <stdint.h>
+#include "export.h"
+
+/* Number of callbacks that can be registered */
+#define CLOCK_CALLBACKS (4)
+/* Most steps of one switch */
+#define CLOCK_MAX_STEPS (8)
+
+#define CLOCK_LDO (0)
+#define CLOCK_DCDC (1)
+
+enum clock_event {
+	CLOCK_PRE_CHANGE,
+	CLOCK_POST_CHANGE,
+};
+
+/**
+ * @brief Clock and power state
+ *
+ * Core clock in Hz, regulator (CLOCK_LDO or CLOCK_DCDC), VCORE level (0
+ * or 1) and the number of flash wait states.
+ */
+struct clock_state {
+	uint32_t hz;
+	uint8_t regulator;
+	uint8_t vcore;
+	uint8_t wait;
+};
+
+/**
+ * @brief Callback of a clock switch
+ *
+ * Called with CLOCK_PRE_CHANGE and the old frequency before the first
+ * step, with CLOCK_POST_CHANGE and the new one after the last step.
+ */
+typedef void (*clock_callback)(enum clock_event event, uint32_t hz,
+	void *arg);
+
+/**
+ * @brief State of a frequency and a regulator
+ *
+ * Fills in the lowest VCORE and the fewest wait states that run the
+ * given clock.
+ *
+ * @param hz Core clock: 1500000, 3000000, 12000000, 24000000 or 48000000
+ * @param regulator CLOCK_LDO or CLOCK_DCDC
+ * @param state The state to fill in
+ *
+ * @return 0 or EINVAL for an unsupported frequency or regulator.
+ */
+EMBEDDED_API int clock_lookup(uint32_t hz, uint8_t regulator,
+	struct clock_state *state);
+
+/**
+ * @brief Steps of a switch
+ *
+ * Each step changes one of the power mode (regulator and VCORE), the
+ * wait states or the clock of the state before it, and every state on
+ * the way runs safely. Used by clock_set().
+ *
+ * @param from Current state
+ * @param to Target state, from clock_lookup()
+ * @param steps Array of CLOCK_MAX_STEPS states after each step
+ *
+ * @return Number of steps, 0 if from is already to.
+ */
+EMBEDDED_API unsigned clock_plan(const struct clock_state *from,
+	const struct clock_state *to, struct clock_state *steps);
+
+/**
+ * @brief Switch the core clock and the regulator
+ *
+ * Calls the callbacks, applies the steps of clock_plan() and updates
+ * SystemCoreClock. The wait state steps set the read buffers of
+ * flash_profile() as well. Time stamps of timing_now() taken before the switch
+ * do not convert to nanoseconds correctly after it.
+ *
+ * @param hz Core clock: 1500000, 3000000, 12000000, 24000000 or 48000000
+ * @param regulator CLOCK_LDO or CLOCK_DCDC
+ *
+ * @return 0 or EINVAL for an unsupported frequency or regulator.
+ */
+EMBEDDED_API int clock_set(uint32_t hz, uint8_t regulator);
+
+/**
+ * @brief Current clock and power state
+ *
+ * Read from the power, flash and clock system registers on MSP432.
+ *
+ * @param state The state to fill in
+ *
+ * @return void.
+ */
+EMBEDDED_API void clock_get(struct clock_state *state);
+
+/**
+ * @brief Register a callback of clock switches
+ *
+ * Registering the same function and argument again has no effect.
+ *
+ * @param cb Function to call
+ * @param arg Argument to pass to it
+ *
+ * @return 0 or ENOMEM when CLOCK_CALLBACKS are registered already.
+ */
+EMBEDDED_API int clock_register(clock_callback cb, void *arg);
+
+/**
+ * @brief Remove a callback registered with the same function and argument
+ *
+ * @param cb Registered function
+ * @param arg Registered argument
+ *
+ * @return void.
+ */
+EMBEDDED_API void clock_unregister(clock_callback cb, void *arg);
+
+#endif /* __CLOCK_H__ */
@@ -0,0 +1,117 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file console.h
+ * @brief Double buffered, DMA driven console output
+ *
+ * Output is collected in one of two buffers while the other one is sent.
+ * On MSP432 the buffer in flight is moved to the eUSCI_A0 UART (P1.3,
+ * the backchannel UART of the LaunchPad) by DMA channel 0, the DMA_INT1
+ * handler hands over the next buffer. The CPU never waits for the UART:
+ * output that does not fit into the buffer being filled is dropped and
+ * counted.
+ *
+ * On HOST the same queue sends to a file descriptor. The transfer of a
+ * buffer completes after the time the UART would need for it, so the
+ * queueing and dropping behave like on the target.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __CONSOLE_H__
+#define __CONSOLE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* Size of each of the two buffers, at most 1024 (one DMA cycle) */
+#ifndef CONSOLE_BUF_SIZE
+#define CONSOLE_BUF_SIZE (1024)
+#endif
+
+/* Longest message of console_printf(), formatted on the stack */
+#ifndef CONSOLE_LINE_SIZE
+#define CONSOLE_LINE_SIZE (256)
+#endif
+
+#ifndef CONSOLE_BAUD
+#define CONSOLE_BAUD (115200)
+#endif
+
+/**
+ * @brief Set up the UART and the DMA channel
+ *
+ * Called by the first console_write(), calling it again resets the
+ * queue.
+ *
+ * @return void.
+ */
+void console_init(void);
+
+/**
+ * @brief Queue bytes for output
+ *
+ * Never waits. Output that does not fit into the free space of the
+ * buffer being filled is dropped as a whole.
+ *
+ * @param data Bytes to send
+ * @param len Number of bytes
+ *
+ * @return Number of bytes queued, len or 0.
+ */
+size_t console_write(const void *data, size_t len);
+
+/**
+ * @brief Format and queue a message, like printf()
+ *
+ * Formats with interrupts enabled into a line of CONSOLE_LINE_SIZE bytes on
+ * the stack, then queues it with console_write(). A longer message is
+ * cut, one that does not fit into the queue is dropped.
+ *
+ * @param fmt printf() format string
+ *
+ * @return Number of bytes queued.
+ */
+int console_printf(const char *fmt, ...)
+	__attribute__((format(printf, 1, 2)));
+
+/**
+ * @brief Wait until the queue is empty
+ *
+ * Sleeps until the pending transfers completed. Must not be called from
+ * an interrupt handler.
+ *
+ * @return void.
+ */
+void console_flush(void);
+
+/**
+ * @brief Number of bytes dropped because the queue was full
+ *
+ * @return Dropped bytes since console_init().
+ */
+uint32_t console_dropped(void);
+
+#if defined (HOST)
+/**
+ * @brief Select the file descriptor of the simulated UART
+ *
+ * Defaults to standard output. Pending output goes to the previous one.
+ *
+ * @param fd File descriptor to write to
+ *
+ * @return void.
+ */
+void console_set_fd(int fd);
+#endif
+
+#endif /* __CONSOLE_H__ */
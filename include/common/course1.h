@@ -20,6 +20,7 @@
 #define __COURSE1_H__
 
 #include <stdint.h>
+#include "testrun.h"
 
 #define DATA_SET_SIZE_W (10)
 #define MEM_SET_SIZE_B  (32)
@@ -29,16 +30,15 @@
 #define TEST_MEMMOVE_LENGTH (16)
 #define TEST_ERROR          (1)
 #define TEST_NO_ERROR       (0)
-#define TESTCOUNT           (8)
 
 /**
  * @brief function to run course1 materials
  * 
- * This function calls some various simple tests that you can run to test 
- * your code for the course 1 final assesment. The contents of these functions
- * have been provided. 
+ * This function runs the table of tests below for all of their cases
+ * that you can run to test your code for the course 1 final assesment.
+ * The contents of these functions have been provided. 
  *
- * @return void
+ * @return Number of failed tests, 0 if all of them passed
  */
 uint8_t course1(void);
 
@@ -48,9 +48,11 @@ uint8_t course1(void);
  * This function calls the my_itoa and my_atoi functions to validate they
  * work as expected for hexadecimal numbers.
  *
+ * @param ctx Case, ctx->param is the number to convert
+ *
  * @return void
  */
-int8_t test_data1();
+int8_t test_data1(struct testrun_ctx *ctx);
 
 /**
  * @brief function to run course1 data operations
@@ -58,9 +60,23 @@ int8_t test_data1();
  * This function calls the my_itoa and my_atoi functions to validate they
  * work as expected for decimal numbers. 
  *
+ * @param ctx Case, ctx->param is the number to convert
+ *
+ * @return void
+ */
+int8_t test_data2(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to sweep the data operations over int32_t
+ * 
+ * This function converts a number spread over the int32_t range by the
+ * case index to binary, decimal and hexadecimal and back.
+ *
+ * @param ctx Case, ctx->param is the case index
+ *
  * @return void
  */
-int8_t test_data2();
+int8_t test_data_sweep(struct testrun_ctx *ctx);
 
 /**
  * @brief function to test the non-overlapped memmove operation
@@ -69,9 +85,11 @@ int8_t test_data2();
  * over lap in anyway. This function should print that a move worked correctly
  * for a move from source to destination.
  *
+ * @param ctx Buffer case, ctx->param is the length to move
+ *
  * @return void
  */
-int8_t test_memmove1();
+int8_t test_memmove1(struct testrun_ctx *ctx);
 
 /**
  * @brief function to test an overlapped Memmove operation Part 1
@@ -79,11 +97,14 @@ int8_t test_memmove1();
  * This function calls the memmove routine with two sets of data that not
  * over lap. Overlap exists at the start of the destination and the end of the
  * source pointers. This function should print that a move worked correctly
- * for a move from source to destination regardless of overlap.
+ * for a move from source to destination regardless of overlap. The
+ * overlap is half of the length.
+ *
+ * @param ctx Buffer case, ctx->param is the length to move
  *
  * @return void
  */
-int8_t test_memmove2();
+int8_t test_memmove2(struct testrun_ctx *ctx);
 
 /**
  * @brief function to run course1 memmove overlapped test
@@ -91,11 +112,14 @@ int8_t test_memmove2();
  * This function calls the memmove routine with two sets of data that not
  * over lap. Overlap exists at the start of the source and the end of the
  * destination pointers. This function should print that a move worked correctly
- * for a move from source to destination regardless of overlap.
+ * for a move from source to destination regardless of overlap. The
+ * overlap is half of the length.
+ *
+ * @param ctx Buffer case, ctx->param is the length to move
  *
  * @return void
  */
-int8_t test_memmove3();
+int8_t test_memmove3(struct testrun_ctx *ctx);
 
 /**
  * @brief function to test the memcopy functionality
@@ -103,29 +127,188 @@ int8_t test_memmove3();
  * This function calls the my_memcopy functions to validate a copy works
  * correctly. 
  *
+ * @param ctx Buffer case, ctx->param is the length to copy
+ *
  * @return void
  */
-int8_t test_memcopy();
+int8_t test_memcopy(struct testrun_ctx *ctx);
 
 /**
  * @brief function to test the memset and memzero functionality
  * 
- * This function calls the memset and memzero functions. This shoudl zero out
- * the bytes from [] to []. This should set the bytes [] to [] with 0xFF.
+ * This function calls the memset and memzero functions. This should set
+ * the first length bytes to 0xFF and zero out the next length bytes.
+ *
+ * @param ctx Buffer case, ctx->param is the length
  *
  * @return void
  */
-int8_t test_memset();
+int8_t test_memset(struct testrun_ctx *ctx);
 
 /**
  * @brief function to test the reverse functionality
  * 
- * This function calls the my_reverse function to see if a give set of ASCII
- * characters will properly reverse.
+ * This function calls the my_reverse function to see if the start of the
+ * buffer will properly reverse.
+ *
+ * @param ctx Buffer case, ctx->param is the length to reverse
+ *
+ * @return void
+ */
+int8_t test_reverse(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to test the selection and percentile functionality
+ * 
+ * This function calls select_nth for every rank of a shuffled set with
+ * duplicates and checks it against a sorted copy. It also checks the
+ * percentile and median corner cases for odd and even sizes.
+ *
+ * @return void
+ */
+int8_t test_percentile(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to test the type specific sort and reductions
+ * 
+ * This function sorts a set of signed 14-bit samples through the radix
+ * path and a byte set through the counting path, then checks the mean
+ * for overflow and the float reductions.
+ *
+ * @return void
+ */
+int8_t test_sort(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to test the report writer
+ * 
+ * This function renders the array and statistics tables into a buffer and
+ * compares them with the expected text. It also checks that a report
+ * which does not fit is truncated and stays terminated.
+ *
+ * @return void
+ */
+int8_t test_report(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to test the log rate limiter
+ * 
+ * This function sends a burst of messages through a rate limited call
+ * site state and checks that only the allowed number gets through and
+ * that the dropped ones are reported with the next interval, and by
+ * log_limit_flush() once the interval of a queued call site has expired.
+ *
+ * @return void
+ */
+int8_t test_log_limit(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to test the console queue
+ * 
+ * This function fills both console buffers through the HOST stand-in of
+ * the UART, checks that further output is dropped instead of waited for
+ * and that the queued output arrives complete and in order, then that
+ * console_printf() queues into the emptied queue.
+ *
+ * @return void
+ */
+int8_t test_console(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to test the deferred log ring buffer
+ * 
+ * This function lets several threads store records into the ring of
+ * logbuf.c while it reads them back, and checks that every record arrives
+ * complete and in the order of its producer. Built with SANITIZE=thread it
+ * also checks the ring for data races. HOST only, built with DEFERRED_LOG.
+ *
+ * @param ctx Unused
+ *
+ * @return void
+ */
+int8_t test_logbuf(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to test the binary flushes of the deferred log
+ * 
+ * This function flushes one record at a time into a file twice and
+ * decodes both batches back, each behind the relocation marker of its
+ * flush. HOST only, built with DEFERRED_LOG.
+ *
+ * @return void
+ */
+int8_t test_logbuf_file(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to test the sequencing of clock switches
+ * 
+ * This function plans the switch between a pair of frequencies and
+ * regulators and checks that every step changes one thing, keeps VCORE and
+ * the flash wait states sufficient for the clock and is a valid power mode
+ * transition. On HOST it also switches the simulated clock and checks the
+ * callbacks and SystemCoreClock.
+ *
+ * @param ctx Case, ctx->param selects the pair of states
+ *
+ * @return void
+ */
+int8_t test_clock(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to test the flash configuration
+ * 
+ * This function checks that the flash profile of a clock has enough wait
+ * states and no more, and that flash_configure refuses too few wait
+ * states, too many and unknown buffers. On HOST it switches the simulated
+ * clock and checks the wait states clock_set applied, on MSP432 it uses
+ * the current clock.
+ *
+ * @param ctx Case, ctx->param selects the clock
+ *
+ * @return void
+ */
+int8_t test_flash(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to test the vector table in SRAM
+ * 
+ * This function checks that the stack pointer, the reset vector and
+ * numbers past the last interrupt are refused. On HOST it registers, swaps
+ * and restores the handler of an interrupt and takes it through the
+ * simulated dispatch.
+ *
+ * @param ctx Case, ctx->param selects the interrupt from VECTORS_FIRST
+ *
+ * @return void
+ */
+int8_t test_vectors(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to test the capture of the crash context
+ * 
+ * This function saves a simulated exception frame with a basic frame, a
+ * padded one, an FPU frame or a broken stack and checks the registers,
+ * the stack pointer before the exception and the return addresses of the
+ * trace, then that a cleared record is gone.
+ *
+ * @param ctx Case, ctx->param selects the frame
+ *
+ * @return void
+ */
+int8_t test_fault(struct testrun_ctx *ctx);
+
+/**
+ * @brief function to run the property based tests of the memory functions
+ * 
+ * This function checks my_memmove, my_memcopy, my_memset and my_reverse
+ * against the C library for random sizes, alignments and overlaps, see
+ * proptest.h for the seed, replay and soak settings. HOST only.
+ *
+ * @param ctx Unused
  *
  * @return void
  */
-int8_t test_reverse();
+int8_t test_property(struct testrun_ctx *ctx);
 
 #endif /* __COURSE1_H__ */
 
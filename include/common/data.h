@@ -26,6 +26,7 @@
 #include <limits.h>
 #include <stdint.h>
 #include "data.h"
+#include "export.h"
 #include "platform.h"
 #include "memory.h"
 
@@ -52,7 +53,7 @@
  * @return The length of the converted data (including a negative sign
  * '-' and '\0').
  */
-uint8_t my_itoa(int32_t data, uint8_t * ptr, uint32_t base);
+EMBEDDED_API uint8_t my_itoa(int32_t data, uint8_t * ptr, uint32_t base);
 
 /**
  * @brief Convert data back from an ASCII represented string into
@@ -69,6 +70,6 @@ uint8_t my_itoa(int32_t data, uint8_t * ptr, uint32_t base);
  *
  * @return The converted 32-bit signed integer in a decimal format.
  */
-int32_t my_atoi(uint8_t * str, uint8_t digits, uint32_t base);
+EMBEDDED_API int32_t my_atoi(uint8_t * str, uint8_t digits, uint32_t base);
 
 #endif /* __DATA_H__ */
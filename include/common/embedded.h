@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file embedded.h
+ * @brief Public interface of libembedded
+ *
+ * libembedded.a and libembedded.so hold the memory, data, stats, report and
+ * timing modules (and the parallel statistics on HOST) for programs outside
+ * of this build, together with the hardware modules clock_*(), flash_*(),
+ * vectors_*() and fault_*() and log_set_level() of log.h. Include this
+ * header only, compile with the platform switch the library was built for
+ * (-DHOST or -DMSP432) and link with -lembedded (and -pthread on HOST).
+ *
+ * On HOST the hardware modules are simulation stand-ins: clock_*() and
+ * flash_*() change a simulated state, vectors_*() dispatches a simulated
+ * table and fault_*() records simulated frames. libembedded.so exports
+ * them so that programs can run the same calls as on the target, they do
+ * not touch any hardware.
+ *
+ * The version follows the shared object: the major number changes with
+ * every incompatible change of the interface and is part of the soname.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __EMBEDDED_H__
+#define __EMBEDDED_H__
+
+#include <stdint.h>
+#include "export.h"
+#include "clock.h"
+#include "flash.h"
+#include "data.h"
+#include "fault.h"
+#include "memory.h"
+#include "report.h"
+#include "stats.h"
+#include "timing.h"
+#include "vectors.h"
+#if defined (HOST)
+#include "pstats.h"
+#endif
+
+#define EMBEDDED_VERSION_MAJOR (1)
+#define EMBEDDED_VERSION_MINOR (0)
+#define EMBEDDED_VERSION_PATCH (0)
+#define EMBEDDED_VERSION_STRING "1.0.0"
+#define EMBEDDED_VERSION ((EMBEDDED_VERSION_MAJOR << 16) | \
+	(EMBEDDED_VERSION_MINOR << 8) | EMBEDDED_VERSION_PATCH)
+
+/**
+ * @brief Version of the library
+ *
+ * Programs linked to the shared object compare it with EMBEDDED_VERSION
+ * to find out whether the header they were built with matches.
+ *
+ * @return EMBEDDED_VERSION of the library build.
+ */
+EMBEDDED_API uint32_t embedded_version(void);
+
+#endif /* __EMBEDDED_H__ */
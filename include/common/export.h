@@ -0,0 +1,32 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file export.h
+ * @brief Symbol visibility of the libembedded API
+ *
+ * libembedded.so is built with -fvisibility=hidden, so only the functions
+ * declared with EMBEDDED_API are exported from it, the helpers shared
+ * between its modules stay internal.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __EXPORT_H__
+#define __EXPORT_H__
+
+#if defined (__GNUC__)
+#define EMBEDDED_API __attribute__((visibility("default")))
+#else
+#define EMBEDDED_API
+#endif
+
+#endif /* __EXPORT_H__ */
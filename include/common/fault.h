@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file fault.h
+ * @brief Crash context of faults, kept over the reset
+ *
+ * NMI_Handler, HardFault_Handler and Default_Handler, which the MemManage,
+ * BusFault and UsageFault handlers and unused interrupts alias, branch to
+ * fault_entry(). It switches to a stack of its own, saves the registers
+ * the core stacked, the fault status and address registers and the
+ * return addresses found on the stack into a NOINIT record, and resets.
+ * fault_report() prints the record on the next boot, tools/faultdecode.c
+ * maps its addresses to the symbols of the ELF file:
+ *
+ *	fault: exception 3
+ *	fault: pc 0x00001f2a lr 0x00001e53 sp 0x20003fc8 xpsr 0x21000000
+ *	fault: r0 0x00000000 r1 0x00000010 r2 0x00000000 r3 0x00000001
+ *	fault: r12 0x00000000 exc_return 0xfffffff9
+ *	fault: cfsr 0x00008200 hfsr 0x40000000 mmfar 0xe000edf4 bfar 0x00000000
+ *	fault: trace 0x00001e53 0x00000a21
+ *
+ * On HOST nothing calls fault_save(), the tests do with a simulated
+ * exception frame, and the status registers read 0.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __FAULT_H__
+#define __FAULT_H__
+
+#include <stdint.h>
+#include "export.h"
+
+/* Return addresses of the stack trace */
+#define FAULT_TRACE (8)
+/* Stack words scanned for them */
+#define FAULT_SCAN (128)
+
+/**
+ * @brief Crash context
+ *
+ * Exception number (2 NMI, 3 HardFault, 4 MemManage, 5 BusFault,
+ * 6 UsageFault, 16 and up the interrupts), the stacked registers, the
+ * stack pointer before the exception, EXC_RETURN, the configurable and
+ * hard fault status registers, the fault addresses and the trace. The
+ * registers are 0 when the stack pointer was outside of SRAM.
+ */
+struct fault_record {
+	uint32_t magic;
+	uint32_t exception;
+	uint32_t r0, r1, r2, r3, r12, lr, pc, xpsr;
+	uint32_t sp;
+	uint32_t exc_return;
+	uint32_t cfsr, hfsr, mmfar, bfar;
+	uint32_t depth;
+	uint32_t trace[FAULT_TRACE];
+	uint32_t check;
+};
+
+/**
+ * @brief Save the crash context of an exception
+ *
+ * The words between the end of the frame and stack_end are scanned for
+ * return addresses, at most FAULT_SCAN of them.
+ *
+ * @param frame Registers the core stacked, or NULL if the stack was broken
+ * @param exc_return EXC_RETURN value of LR at the exception entry
+ * @param stack_end End of the stack the frame is on
+ *
+ * @return void.
+ */
+EMBEDDED_API void fault_save(const uint32_t *frame, uint32_t exc_return,
+	const uint32_t *stack_end);
+
+/**
+ * @brief Saved crash context
+ *
+ * @param rec The record to fill in
+ *
+ * @return 0 or ENOENT if there is no valid record.
+ */
+EMBEDDED_API int fault_get(struct fault_record *rec);
+
+/**
+ * @brief Forget the saved crash context
+ *
+ * @return void.
+ */
+EMBEDDED_API void fault_clear(void);
+
+/**
+ * @brief Print and forget the crash context of the last boot
+ *
+ * Called by main() at every boot.
+ *
+ * @return 1 if a record was printed, 0 otherwise.
+ */
+EMBEDDED_API uint8_t fault_report(void);
+
+#endif /* __FAULT_H__ */
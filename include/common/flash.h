@@ -0,0 +1,132 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file flash.h
+ * @brief Wait states and read buffering of the flash controller
+ *
+ * Above 12 MHz (16 MHz on VCORE1) a flash read takes extra cycles, the wait
+ * states. The instruction (BUFI) and data (BUFD) read buffers of both banks
+ * keep the last 128 bit line, so sequential fetches of a loop do not wait
+ * for every word. The MSP432P401R has no prefetch beyond these buffers.
+ *
+ * flash_profile() is the configuration clock_set() applies with every
+ * clock, flash_measure() times the memory.c and stats.c kernels under each
+ * safe configuration to find the fastest one.
+ *
+ * On HOST the configuration is a simulated state.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __FLASH_H__
+#define __FLASH_H__
+
+#include <stdint.h>
+#include "export.h"
+
+/* Instruction and data read buffers */
+#define FLASH_BUFI (0x1)
+#define FLASH_BUFD (0x2)
+
+/* Most wait states of the controller */
+#define FLASH_MAX_WAIT (15)
+
+/* Kernels and runs of flash_measure() */
+#define FLASH_MEASURE_SIZE (256)
+#define FLASH_MEASURE_RUNS (8)
+
+/**
+ * @brief Flash configuration
+ *
+ * Wait states and FLASH_BUFI, FLASH_BUFD flags, the same for both banks.
+ */
+struct flash_config {
+	uint8_t wait;
+	uint8_t buffer;
+};
+
+/**
+ * @brief Fewest wait states of a clock
+ *
+ * @param hz Core clock in Hz
+ * @param vcore VCORE level, 0 or 1
+ *
+ * @return Wait states of the datasheet.
+ */
+EMBEDDED_API uint8_t flash_min_wait(uint32_t hz, uint8_t vcore);
+
+/**
+ * @brief Configuration of a clock
+ *
+ * The fewest wait states, and both read buffers when there are wait
+ * states. Without wait states the buffers save nothing.
+ *
+ * @param hz Core clock in Hz
+ * @param vcore VCORE level, 0 or 1
+ * @param cfg The configuration to fill in
+ *
+ * @return void.
+ */
+EMBEDDED_API void flash_profile(uint32_t hz, uint8_t vcore,
+	struct flash_config *cfg);
+
+/**
+ * @brief Apply a configuration
+ *
+ * @param cfg Configuration to apply
+ *
+ * @return 0 or EINVAL for fewer wait states than the current clock needs,
+ * more than FLASH_MAX_WAIT or unknown buffer flags.
+ */
+EMBEDDED_API int flash_configure(const struct flash_config *cfg);
+
+/**
+ * @brief Apply flash_profile() for a number of wait states
+ *
+ * No check against the current clock, clock_set() calls it between the
+ * steps of a switch.
+ *
+ * @param wait Wait states
+ *
+ * @return void.
+ */
+EMBEDDED_API void flash_wait(uint8_t wait);
+
+/**
+ * @brief Current configuration
+ *
+ * Read from the flash controller on MSP432.
+ *
+ * @param cfg The configuration to fill in
+ *
+ * @return void.
+ */
+EMBEDDED_API void flash_get(struct flash_config *cfg);
+
+/**
+ * @brief Time the kernels under each safe configuration
+ *
+ * Prints the fastest of FLASH_MEASURE_RUNS calls of my_memcopy(),
+ * sort_array() and find_median() on FLASH_MEASURE_SIZE bytes, for the
+ * fewest wait states of the current clock and one more, with each
+ * combination of buffers. my_memcopy() runs from SRAM on MSP432 and times
+ * the data reads of a const table in flash, sort_array() and
+ * find_median() time the instruction fetches from flash on a copy in
+ * SRAM. The configuration is restored afterwards.
+ *
+ * @param best The configuration with the lowest total
+ *
+ * @return Number of configurations measured.
+ */
+EMBEDDED_API unsigned flash_measure(struct flash_config *best);
+
+#endif /* __FLASH_H__ */
@@ -0,0 +1,244 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file log.h
+ * @brief Leveled logging on top of PRINTF()
+ *
+ * Every module picks its compile time threshold before it includes this
+ * header:
+ *
+ *	#define LOG_MODULE_LEVEL DATA_LOG_LEVEL
+ *	#include "log.h"
+ *
+ * Call sites above the module threshold expand to nothing, so neither
+ * their code nor their format strings end up in the image. Call sites that
+ * are compiled in are also checked against the runtime threshold
+ * log_level.
+ *
+ * The global threshold LOG_LEVEL is TRACE with -DVERBOSE and INFO
+ * otherwise, the module thresholds (MEMORY_LOG_LEVEL, DATA_LOG_LEVEL,
+ * STATS_LOG_LEVEL, COURSE1_LOG_LEVEL) default to LOG_LEVEL.
+ *
+ * Hot paths use the rate limited LOG_RATELIMITED() or the sampled
+ * LOG_SAMPLED() variants. Both keep their counters per call site.
+ * LOG_SAMPLED() reports how many messages it dropped with the next message
+ * that gets through. A LOG_RATELIMITED() site reports them once its
+ * interval has expired, at the next rate limited message of any site or
+ * at log_limit_flush(), so the count of a flood that stopped is printed
+ * too.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __LOG_H__
+#define __LOG_H__
+
+#include <stdint.h>
+#include "export.h"
+#include "platform.h"
+
+#define LOG_LEVEL_NONE (0)
+#define LOG_LEVEL_ERROR (1)
+#define LOG_LEVEL_WARN (2)
+#define LOG_LEVEL_INFO (3)
+#define LOG_LEVEL_DEBUG (4)
+#define LOG_LEVEL_TRACE (5)
+
+#ifndef LOG_LEVEL
+#ifdef VERBOSE
+#define LOG_LEVEL LOG_LEVEL_TRACE
+#else
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+#endif
+
+#ifndef MEMORY_LOG_LEVEL
+#define MEMORY_LOG_LEVEL LOG_LEVEL
+#endif
+#ifndef DATA_LOG_LEVEL
+#define DATA_LOG_LEVEL LOG_LEVEL
+#endif
+#ifndef STATS_LOG_LEVEL
+#define STATS_LOG_LEVEL LOG_LEVEL
+#endif
+#ifndef COURSE1_LOG_LEVEL
+#define COURSE1_LOG_LEVEL LOG_LEVEL
+#endif
+
+#ifndef LOG_MODULE_LEVEL
+#define LOG_MODULE_LEVEL LOG_LEVEL
+#endif
+
+/* Usable in #if to drop whole blocks, e.g. #if LOG_ENABLED(TRACE) */
+#define LOG_ENABLED(level) (LOG_MODULE_LEVEL >= LOG_LEVEL_##level)
+
+/**
+ * @brief Runtime threshold
+ *
+ * Messages with a level above it are not printed. Defaults to
+ * LOG_LEVEL_TRACE, so everything that is compiled in is printed.
+ */
+extern volatile uint8_t log_level;
+
+/**
+ * @brief Set the runtime threshold
+ *
+ * @param level One of LOG_LEVEL_NONE ... LOG_LEVEL_TRACE
+ *
+ * @return The previous threshold.
+ */
+EMBEDDED_API uint8_t log_set_level(uint8_t level);
+
+#define LOG_PRINTF(level, ...) do {						\
+		if (LOG_LEVEL_##level <= log_level)				\
+			PRINTF(__VA_ARGS__);					\
+	} while (0)
+
+#define LOG_NOTHING(...) do { } while (0)
+
+/**
+ * @brief Per call site state of LOG_RATELIMITED()
+ *
+ * States with a file are queued for log_limit_flush() while they have
+ * dropped messages.
+ */
+struct log_limit {
+	uint32_t begin;
+	uint32_t printed;
+	uint32_t suppressed;
+	uint32_t interval_ms;
+	const char *file;
+	int line;
+	uint8_t severity;
+	uint8_t queued;
+	struct log_limit *next;
+};
+
+/* Defaults of the rate limited call sites: 10 messages per second */
+#define LOG_LIMIT_INTERVAL_MS (1000)
+#define LOG_LIMIT_BURST (10)
+
+/**
+ * @brief Millisecond clock of the rate limiter
+ *
+ * Based on timing_now(), weak so that a platform with a tick counter can
+ * provide a cheaper one.
+ *
+ * @return Milliseconds since an arbitrary point in time.
+ */
+uint32_t log_clock_ms(void);
+
+/**
+ * @brief Account one message of a rate limited call site
+ *
+ * Lets at most burst messages through per interval_ms. The first message
+ * of a new interval collects the number of messages that were dropped in
+ * the previous one, unless log_limit_flush() has reported them already.
+ * Reports the expired intervals of the other queued call sites first.
+ *
+ * @param lim Call site state, zero initialized
+ * @param interval_ms Length of an interval in ms
+ * @param burst Messages allowed per interval
+ * @param suppressed Number of dropped messages to report, or 0
+ *
+ * @return 1 if the message should be printed, 0 otherwise.
+ */
+int log_limit_check(struct log_limit *lim, uint32_t interval_ms,
+	uint32_t burst, uint32_t *suppressed);
+
+/**
+ * @brief Report the dropped messages of the queued call sites
+ *
+ * Prints "<file>:<line>: <n> messages suppressed" at the level of the call
+ * site and starts a new interval for it. PRINTF_FLUSH() calls it with all
+ * set, a periodic tick can call it to report floods that stopped.
+ *
+ * @param all 1 for every queued call site, 0 for those whose interval has
+ * expired
+ *
+ * @return void.
+ */
+void log_limit_flush(uint8_t all);
+
+#define LOG_RATELIMITED(level, ...) LOG_RATELIMITED_N(level,			\
+		LOG_LIMIT_INTERVAL_MS, LOG_LIMIT_BURST, __VA_ARGS__)
+
+#define LOG_RATELIMITED_N(level, interval_ms, burst, ...) LOG_SITE_##level(	\
+	do {									\
+		static struct log_limit log_limit_ = {			\
+			.file = __FILE__, .line = __LINE__,			\
+			.severity = LOG_LEVEL_##level };			\
+		uint32_t log_missed_;						\
+		if (log_limit_check(&log_limit_, (interval_ms), (burst),	\
+			&log_missed_)) {					\
+			if (log_missed_)					\
+				LOG_PRINTF(level, "%s:%d: %lu messages "	\
+					"suppressed\n", __FILE__, __LINE__,	\
+					(unsigned long)log_missed_);		\
+			LOG_PRINTF(level, __VA_ARGS__);				\
+		}								\
+	} while (0))
+
+/* Only every n-th message of the call site, starting with the first one */
+#define LOG_SAMPLED(level, n, ...) LOG_SITE_##level(				\
+	do {									\
+		static uint32_t log_seen_;					\
+		if (log_seen_++ % (n) == 0) {					\
+			if (log_seen_ > 1 && (n) > 1)				\
+				LOG_PRINTF(level, "%s:%d: %lu messages "	\
+					"sampled out\n", __FILE__, __LINE__,	\
+					(unsigned long)((n) - 1));		\
+			LOG_PRINTF(level, __VA_ARGS__);				\
+		}								\
+	} while (0))
+
+#if LOG_ENABLED(ERROR)
+#define LOG_ERROR(...) LOG_PRINTF(ERROR, __VA_ARGS__)
+#define LOG_SITE_ERROR(...) __VA_ARGS__
+#else
+#define LOG_ERROR(...) LOG_NOTHING()
+#define LOG_SITE_ERROR(...) LOG_NOTHING()
+#endif
+
+#if LOG_ENABLED(WARN)
+#define LOG_WARN(...) LOG_PRINTF(WARN, __VA_ARGS__)
+#define LOG_SITE_WARN(...) __VA_ARGS__
+#else
+#define LOG_WARN(...) LOG_NOTHING()
+#define LOG_SITE_WARN(...) LOG_NOTHING()
+#endif
+
+#if LOG_ENABLED(INFO)
+#define LOG_INFO(...) LOG_PRINTF(INFO, __VA_ARGS__)
+#define LOG_SITE_INFO(...) __VA_ARGS__
+#else
+#define LOG_INFO(...) LOG_NOTHING()
+#define LOG_SITE_INFO(...) LOG_NOTHING()
+#endif
+
+#if LOG_ENABLED(DEBUG)
+#define LOG_DEBUG(...) LOG_PRINTF(DEBUG, __VA_ARGS__)
+#define LOG_SITE_DEBUG(...) __VA_ARGS__
+#else
+#define LOG_DEBUG(...) LOG_NOTHING()
+#define LOG_SITE_DEBUG(...) LOG_NOTHING()
+#endif
+
+#if LOG_ENABLED(TRACE)
+#define LOG_TRACE(...) LOG_PRINTF(TRACE, __VA_ARGS__)
+#define LOG_SITE_TRACE(...) __VA_ARGS__
+#else
+#define LOG_TRACE(...) LOG_NOTHING()
+#define LOG_SITE_TRACE(...) LOG_NOTHING()
+#endif
+
+#endif /* __LOG_H__ */
@@ -0,0 +1,218 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file logbuf.h
+ * @brief Binary deferred logging
+ *
+ * With the -DDEFERRED_LOG compile time switch every PRINTF() call site only
+ * stores the address of its format string and the raw bits of its
+ * arguments into a lock-free ring buffer. Formatting is deferred to
+ * logbuf_flush(), or to the host, where tools/logdecode reads the format
+ * strings back from .rodata of the ELF file.
+ *
+ * Arguments are stored as 32-bit words: one word for values of up to
+ * 32 bits, two words for 64-bit values. float and double arguments are
+ * stored as double, like printf() receives them. "%s" arguments are
+ * stored by address, so they must point to constant strings such as
+ * literals or __func__.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __LOGBUF_H__
+#define __LOGBUF_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#if defined (HOST)
+#include <stdio.h>
+#endif
+
+/* Number of records in the ring, a power of two */
+#ifndef LOGBUF_RECORDS
+#if defined (MSP432)
+#define LOGBUF_RECORDS (64)
+#else
+#define LOGBUF_RECORDS (64 * 1024)
+#endif
+#endif
+
+/* Argument words kept per record, the rest is dropped */
+#define LOGBUF_MAX_WORDS (12)
+
+/**
+ * @brief One PRINTF() call
+ *
+ * seq is the position of the record in the log stream counted from 1.
+ * nwords is the number of argument words the call site produced, words
+ * holds at most LOGBUF_MAX_WORDS of them.
+ */
+struct logbuf_record {
+	uint32_t seq;
+	uint32_t nwords;
+	const char *fmt;
+	uint32_t words[LOGBUF_MAX_WORDS];
+};
+
+/**
+ * @brief Store one record
+ *
+ * Lock-free, may be called from any thread or interrupt handler. When
+ * the ring is full the oldest record is overwritten.
+ *
+ * @param fmt Format string, must be a string constant
+ * @param words Argument words
+ * @param nwords Number of argument words
+ *
+ * @return void.
+ */
+void logbuf_put(const char *fmt, const uint32_t *words, uint32_t nwords);
+
+/**
+ * @brief Take the oldest record out of the ring
+ *
+ * Must not be called from more than one context at a time.
+ *
+ * @param rec Where to copy the record to
+ *
+ * @return 1 if a record was copied, 0 if the ring is empty.
+ */
+int logbuf_read(struct logbuf_record *rec);
+
+/**
+ * @brief Number of records overwritten before they could be read
+ *
+ * @return Number of lost records since start.
+ */
+uint32_t logbuf_dropped(void);
+
+/**
+ * @brief Drain the ring
+ *
+ * On HOST the records are printed to stdout, or written in binary to the
+ * file named by the LOGBUF_FILE environment variable for tools/logdecode.
+ * The first flush creates the file, the later ones append to it. On other
+ * platforms they are passed in binary to logbuf_sink().
+ *
+ * @return void.
+ */
+void logbuf_flush(void);
+
+#if defined (HOST)
+/**
+ * @brief Write the binary records of the next flushes to another file
+ *
+ * Flushes the ring to the current destination first.
+ *
+ * @param file Open binary file, or NULL for text on stdout
+ *
+ * @return The previous file, NULL for stdout.
+ */
+FILE *logbuf_set_file(FILE *file);
+#endif
+
+/**
+ * @brief Output channel for binary records
+ *
+ * Receives every record as: seq and nwords (32 bits each), the format
+ * string address (pointer size), then nwords argument words. Every flush
+ * starts with a record of seq 0 that carries the address of logbuf_put()
+ * instead of a format string, so the decoder can relocate position
+ * independent executables. The default weak implementation drops the
+ * data, a platform output channel overrides it.
+ *
+ * @param data Pointer to the bytes to send
+ * @param len Number of bytes to send
+ *
+ * @return void.
+ */
+void logbuf_sink(const void *data, size_t len);
+
+/**
+ * @brief Format a record as printf() would have done
+ *
+ * @param out Buffer for the '\0' terminated text
+ * @param size Size of out in bytes
+ * @param fmt Format string of the record
+ * @param rec Record to format
+ * @param ptr_size Size of pointers and long on the producing platform
+ * @param string Resolves the address of a "%s" argument, may return NULL
+ *
+ * @return Length of the text.
+ */
+size_t logbuf_format(char *out, size_t size, const char *fmt,
+	const struct logbuf_record *rec, unsigned ptr_size,
+	const char *(*string)(uint64_t addr));
+
+/* Raw bits of a real argument, promoted to double */
+static inline uint64_t logbuf_real(double value) {
+	union {
+		double d;
+		uint64_t u;
+	} bits;
+
+	bits.d = value;
+
+	return bits.u;
+}
+
+/*
+ * __builtin_classify_type() tells pointers (5) and reals (8) from integers.
+ * The inner __builtin_choose_expr() keep the unused branches well typed.
+ */
+#define LOGBUF_IS_PTR(x) (__builtin_classify_type(x) == 5)
+#define LOGBUF_IS_REAL(x) (__builtin_classify_type(x) == 8)
+
+#define LOGBUF_BITS(x)							\
+	__builtin_choose_expr(LOGBUF_IS_REAL(x),				\
+		logbuf_real(__builtin_choose_expr(LOGBUF_IS_REAL(x), (x), 0.0)), \
+	__builtin_choose_expr(LOGBUF_IS_PTR(x),					\
+		(uint64_t)(uintptr_t)__builtin_choose_expr(LOGBUF_IS_PTR(x),	\
+			(x), (void *)0),					\
+		(uint64_t)__builtin_choose_expr(LOGBUF_IS_PTR(x) ||		\
+			LOGBUF_IS_REAL(x), 0, (x))))
+
+/* Size of the argument after the default argument promotions */
+#define LOGBUF_SIZE(x) (LOGBUF_IS_REAL(x) ? 8 : sizeof((x) + 0))
+
+#define LOGBUF_ARG(ptr, x) do {						\
+		uint64_t bits_ = LOGBUF_BITS(x);				\
+		*(ptr)++ = (uint32_t)bits_;					\
+		if (LOGBUF_SIZE(x) > 4)						\
+			*(ptr)++ = (uint32_t)(bits_ >> 32);			\
+	} while (0);
+
+#define LOGBUF_EACH_0(p, ...)
+#define LOGBUF_EACH_1(p, a) LOGBUF_ARG(p, a)
+#define LOGBUF_EACH_2(p, a, ...) LOGBUF_ARG(p, a) LOGBUF_EACH_1(p, __VA_ARGS__)
+#define LOGBUF_EACH_3(p, a, ...) LOGBUF_ARG(p, a) LOGBUF_EACH_2(p, __VA_ARGS__)
+#define LOGBUF_EACH_4(p, a, ...) LOGBUF_ARG(p, a) LOGBUF_EACH_3(p, __VA_ARGS__)
+#define LOGBUF_EACH_5(p, a, ...) LOGBUF_ARG(p, a) LOGBUF_EACH_4(p, __VA_ARGS__)
+#define LOGBUF_EACH_6(p, a, ...) LOGBUF_ARG(p, a) LOGBUF_EACH_5(p, __VA_ARGS__)
+#define LOGBUF_EACH_7(p, a, ...) LOGBUF_ARG(p, a) LOGBUF_EACH_6(p, __VA_ARGS__)
+#define LOGBUF_EACH_8(p, a, ...) LOGBUF_ARG(p, a) LOGBUF_EACH_7(p, __VA_ARGS__)
+
+/* Number of arguments after the format string, up to 8 */
+#define LOGBUF_NARG(...) LOGBUF_NARG_(__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0, ~)
+#define LOGBUF_NARG_(fmt, _1, _2, _3, _4, _5, _6, _7, _8, n, ...) n
+
+#define LOGBUF_PUT(...) LOGBUF_PUT_(LOGBUF_NARG(__VA_ARGS__), __VA_ARGS__)
+#define LOGBUF_PUT_(n, ...) LOGBUF_PUT_N(n, __VA_ARGS__)
+#define LOGBUF_PUT_N(n, fmt, ...) do {					\
+		uint32_t words_[2 * (n) + 1];					\
+		uint32_t *ptr_ = words_;					\
+		LOGBUF_EACH_##n(ptr_, __VA_ARGS__)				\
+		logbuf_put(fmt, (n) ? words_ : NULL,				\
+			(uint32_t)(ptr_ - words_));				\
+	} while (0)
+
+#endif /* __LOGBUF_H__ */
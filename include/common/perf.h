@@ -0,0 +1,57 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file perf.h
+ * @brief Performance regression check of the memory, data and stats kernels
+ *
+ * Every kernel is timed in a number of trials, each one long enough for
+ * the clock resolution not to matter, and reported as the median time per
+ * call. On HOST the samples are compared with a JSON baseline: the ratio
+ * of the medians and its bootstrap confidence interval tell whether the
+ * kernel got slower, and a kernel whose whole interval lies above the
+ * threshold counts as a regression.
+ *
+ * Environment (HOST):
+ *	PERF_TRIALS - number of trials per kernel
+ *	PERF_THRESHOLD - allowed slowdown in percent
+ *	PERF_BASELINE - JSON file to compare with
+ *	PERF_SAVE - JSON file to write the samples of this run to
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __PERF_H__
+#define __PERF_H__
+
+#include <stdint.h>
+
+#define PERF_TRIALS (15)
+#define PERF_MAX_TRIALS (101)
+#define PERF_THRESHOLD (5)
+/* Time of one trial, the calls per trial are calibrated to it */
+#define PERF_TRIAL_NS (2000000ULL)
+/* Bootstrap resamples and the two-sided confidence level in percent */
+#define PERF_RESAMPLES (2000)
+#define PERF_CONFIDENCE (95)
+
+/**
+ * @brief function to run the performance check
+ *
+ * This function times every kernel, prints the median time per call and,
+ * if a baseline is given, the comparison with it. It is called from main()
+ * when the -DPERF compile time switch is given.
+ *
+ * @return Number of kernels that regressed beyond the threshold
+ */
+uint8_t perf(void);
+
+#endif /* __PERF_H__ */
@@ -16,13 +16,31 @@
 ******************************************************************************/
 #if defined (MSP432)
 #include "msp432p401r.h"
-#define PRINTF(...)
+#include "console.h"
+#define PRINTF(...) console_printf(__VA_ARGS__)
+#define PRINTF_DRAIN() console_flush()
+/* Copied from flash to SRAM_CODE by Reset_Handler, the function then runs
+ * without flash wait states. Its loops stay loops instead of calls to the
+ * memcpy()/memset() of the C library, which live in flash.
+ */
+#define RAMFUNC __attribute__((section(".ramfunc"), noinline,	\
+	optimize("no-tree-loop-distribute-patterns")))
+/* Not zeroed by Reset_Handler, keeps its value over a reset */
+#define NOINIT __attribute__((section(".noinit")))
 /******************************************************************************
  Platform - HOST
 ******************************************************************************/
 #elif defined (HOST)
+#include <stdint.h>
 #include <stdio.h>
+/* Stand-in of system_msp432p401r.c, the core clock of the CLOCK profile
+ * for converting times to cycles, defined in timing.c
+ */
+extern uint32_t SystemCoreClock;
 #define PRINTF(...) printf(__VA_ARGS__)
+#define PRINTF_DRAIN()
+#define RAMFUNC
+#define NOINIT
 /******************************************************************************
  Platform - Unsupported
 ******************************************************************************/
@@ -30,5 +48,24 @@
 #error "Platform provided is not supported in this Build System"
 #endif
 
+/******************************************************************************
+ Deferred logging - PRINTF() only stores its arguments, see logbuf.h
+******************************************************************************/
+/* Suppressed counts of the rate limited call sites, see log.h */
+void log_limit_flush(uint8_t all);
+
+#if defined (DEFERRED_LOG)
+#include "logbuf.h"
+#undef PRINTF
+#define PRINTF(...) LOGBUF_PUT(__VA_ARGS__)
+#define PRINTF_FLUSH() do {						\
+		log_limit_flush(1);					\
+		logbuf_flush();						\
+		PRINTF_DRAIN();						\
+	} while (0)
+#else
+#define PRINTF_FLUSH() do { log_limit_flush(1); PRINTF_DRAIN(); } while (0)
+#endif
+
 #endif /* __PLATFORM_H__ */
 
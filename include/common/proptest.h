@@ -0,0 +1,70 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file proptest.h
+ * @brief Property based tests of memory.c (HOST)
+ *
+ * Every case draws a random operation (my_memmove, my_memcopy, my_memset
+ * or my_reverse), buffer size, alignment, length, offsets and overlap
+ * layout from its own seed and compares the whole buffer including guard
+ * bytes with the C library reference. A failing case is shrunk to a
+ * minimal one and printed together with its seed, which replays it.
+ *
+ * Environment:
+ *	PROPTEST_SEED - seed of the run, cases are derived from it
+ *	PROPTEST_CASES - number of cases
+ *	PROPTEST_SOAK - run for this many seconds instead of a fixed number
+ *	PROPTEST_REPLAY - run only the case with this seed
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __PROPTEST_H__
+#define __PROPTEST_H__
+
+#include <stdint.h>
+
+#define PROPTEST_SEED (0x5EED2026u)
+#define PROPTEST_CASES (2000)
+
+/**
+ * @brief Settings of a run
+ *
+ * soak_s, when not 0, replaces cases by a time budget. replay, when not
+ * 0, runs only the case with that seed.
+ */
+struct proptest_config {
+	uint64_t seed;
+	uint32_t cases;
+	uint32_t soak_s;
+	uint64_t replay;
+};
+
+/**
+ * @brief Defaults, overridden by the PROPTEST_* environment variables
+ *
+ * @param cfg Settings to fill in
+ *
+ * @return void.
+ */
+void proptest_config(struct proptest_config *cfg);
+
+/**
+ * @brief Run the property tests
+ *
+ * @param cfg Settings of the run
+ *
+ * @return Number of failed cases.
+ */
+uint32_t proptest_run(const struct proptest_config *cfg);
+
+#endif /* __PROPTEST_H__ */
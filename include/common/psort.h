@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file: psort.h
+ * @brief: Parallel radix sort of large host-side arrays.
+ *
+ * Multi-threaded LSD radix sort of 8, 16 and 32-bit keys, reordering
+ * from large to small like sort_array(). Every pass counts the digits of
+ * each thread's slice into a private histogram, turns all histograms
+ * into scatter offsets with one prefix sum and lets every thread scatter
+ * its slice through cache line sized write-combining buffers. Passes in
+ * which all keys share the same digit are skipped. 8-bit keys are sorted
+ * by counting only. Available on HOST only, sort_array_<sfx>() switches to
+ * it from PSORT_MIN_SIZE elements on.
+ *
+ * @author: Valentina Krasnobaeva
+ * @date: 10/18/2026
+ *
+ */
+#ifndef __PSORT_H__
+#define __PSORT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* sort_array_<sfx>() hands arrays of at least this size to psort */
+#define PSORT_MIN_SIZE (64 * 1024)
+
+/* Slices shorter than this are not worth a thread of their own */
+#define PSORT_MIN_SLICE (32 * 1024)
+
+/**
+ * @brief: Reorders the given array from large to small in parallel.
+ *
+ * psort_<sfx>(array, size, threads) is instantiated for u8 (uint8_t),
+ * i16 (int16_t), i32 (int32_t) and f32 (float, ordered by value, NaNs
+ * are not supported).
+ *
+ * @param: array The pointer to the first element of the array to reorder
+ * @param: size_t size The number of elements in the array
+ * @param: unsigned threads The number of threads, 0 for pstats_threads()
+ * @return: int 0 on success, ENOMEM if the scratch buffer could not be
+ *	    allocated, the array is left untouched then
+ *
+ */
+#define PSORT_DECLARE(SFX, T)						\
+	int psort_##SFX(T * array, size_t size, unsigned threads);
+
+PSORT_DECLARE(u8, uint8_t)
+PSORT_DECLARE(i16, int16_t)
+PSORT_DECLARE(i32, int32_t)
+PSORT_DECLARE(f32, float)
+
+#endif /* __PSORT_H__ */
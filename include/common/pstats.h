@@ -0,0 +1,134 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file: pstats.h
+ * @brief: Parallel statistics over large host-side data sets.
+ *
+ * Splits a data set of 8-bit or 16-bit samples across worker threads.
+ * Every worker builds a private histogram of its slice, the histograms
+ * are merged once all workers are done. The merged histogram holds the
+ * whole distribution, so maximum, minimum, mean, median and any
+ * percentile are exact and agree with the functions in stats.h. The
+ * input array is not modified. Available on HOST only.
+ *
+ * @author: Valentina Krasnobaeva
+ * @date: 10/18/2026
+ *
+ */
+#ifndef __PSTATS_H__
+#define __PSTATS_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "export.h"
+
+/* Slices shorter than this are not worth a thread of their own */
+#define PSTATS_MIN_SLICE (64 * 1024)
+
+/**
+ * @brief: Merged distribution of a data set.
+ *
+ * hist[i] holds the number of samples equal to (offset + i).
+ */
+struct pstats {
+	size_t count;
+	int64_t sum;
+	int32_t min;
+	int32_t max;
+	int32_t offset;
+	size_t bins;
+	size_t *hist;
+};
+
+/**
+ * @brief: Returns the default number of worker threads.
+ *
+ * Returns the value of the PSTATS_THREADS environment variable if it is
+ * set to a positive number, otherwise the number of online CPUs.
+ *
+ * @return: unsigned The default number of worker threads
+ *
+ */
+EMBEDDED_API unsigned pstats_threads(void);
+
+/**
+ * @brief: Collects statistics of the given unsigned char array.
+ *
+ * @param: struct pstats * st Result, release it with pstats_free()
+ * @param: unsigned char * array The pointer to the first element of
+ *				 unsigned char array to analyze
+ * @param: size_t size The number of elements in the array
+ * @param: unsigned threads The number of worker threads, 0 for
+ *			   pstats_threads()
+ * @return: int 0 on success, ENOMEM if histograms could not be
+ *	    allocated. Workers which cannot get a thread run inline.
+ *
+ */
+EMBEDDED_API int pstats_collect_u8(struct pstats * st, const uint8_t * array,
+	size_t size, unsigned threads);
+
+/**
+ * @brief: Collects statistics of the given signed 16-bit array.
+ *
+ * Same as pstats_collect_u8(), for int16_t samples.
+ *
+ */
+EMBEDDED_API int pstats_collect_i16(struct pstats * st, const int16_t * array,
+	size_t size, unsigned threads);
+
+/**
+ * @brief: Finds the p-th percentile with the nearest-rank method.
+ *
+ * @param: struct pstats * st Collected statistics
+ * @param: unsigned char p The percentile to find, from 0 to 100
+ * @return: int32_t The percentile value, 0 for an empty data set
+ *
+ */
+EMBEDDED_API int32_t pstats_percentile(const struct pstats * st, uint8_t p);
+
+/**
+ * @brief: Calculates the median, averaging the two middle samples for
+ *	   an even count.
+ *
+ * @param: struct pstats * st Collected statistics
+ * @return: int32_t The median value, 0 for an empty data set
+ *
+ */
+EMBEDDED_API int32_t pstats_median(const struct pstats * st);
+
+/**
+ * @brief: Calculates the mean, truncated toward zero.
+ *
+ * @param: struct pstats * st Collected statistics
+ * @return: int32_t The mean value, 0 for an empty data set
+ *
+ */
+EMBEDDED_API int32_t pstats_mean(const struct pstats * st);
+
+/**
+ * @brief: Print statistics in a nicely format.
+ *
+ * @param: struct pstats * st Collected statistics
+ * @return: void
+ *
+ */
+EMBEDDED_API void pstats_print(const struct pstats * st);
+
+/**
+ * @brief: Releases the histogram of collected statistics.
+ *
+ * @param: struct pstats * st Collected statistics
+ * @return: void
+ *
+ */
+EMBEDDED_API void pstats_free(struct pstats * st);
+
+#endif /* __PSTATS_H__ */
@@ -0,0 +1,104 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file report.h
+ * @brief Zero-allocation statistics report writer
+ *
+ * This header file provides functions to render the statistics and array
+ * tables of stats.c into a caller supplied byte buffer. Numbers are
+ * converted with my_itoa() from data.c, so neither printf nor the heap is
+ * needed and the rendered report can be handed to a UART DMA in one
+ * transfer. The output matches print_statistics() and print_array().
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __REPORT_H__
+#define __REPORT_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include "export.h"
+
+/**
+ * @brief Report being rendered into a caller supplied buffer
+ *
+ * The text in buf is always '\0' terminated, so at most size - 1 bytes
+ * are used. Anything that does not fit is dropped and sets truncated.
+ */
+struct report {
+	uint8_t *buf;
+	size_t size;
+	size_t len;
+	uint8_t truncated;
+};
+
+/**
+ * @brief Start a new report in the given buffer
+ *
+ * @param rp Report to initialize
+ * @param buf Pointer to the buffer to render into
+ * @param size Size of the buffer in bytes, at least 1
+ *
+ * @return void.
+ */
+EMBEDDED_API void report_init(struct report *rp, uint8_t *buf, size_t size);
+
+/**
+ * @brief Append a '\0' terminated string
+ *
+ * @param rp Report to append to
+ * @param str String to append
+ *
+ * @return void.
+ */
+EMBEDDED_API void report_str(struct report *rp, const char *str);
+
+/**
+ * @brief Append a signed 32-bit integer
+ *
+ * @param rp Report to append to
+ * @param value Integer to append
+ * @param base Integer base, supported values: 2, 10, 16
+ *
+ * @return void.
+ */
+EMBEDDED_API void report_int(struct report *rp, int32_t value, uint32_t base);
+
+/**
+ * @brief Append the array table, same format as print_array()
+ *
+ * @param rp Report to append to
+ * @param array Pointer to the first element of the array
+ * @param size Number of elements in the array
+ *
+ * @return Number of bytes in the report.
+ */
+EMBEDDED_API size_t report_array(struct report *rp, uint8_t *array,
+	size_t size);
+
+/**
+ * @brief Append the statistics table, same format as print_statistics()
+ *
+ * The median is found with select_nth(), which partially reorders the
+ * array in place.
+ *
+ * @param rp Report to append to
+ * @param array Pointer to the first element of the array
+ * @param size Number of elements in the array
+ *
+ * @return Number of bytes in the report.
+ */
+EMBEDDED_API size_t report_statistics(struct report *rp, uint8_t *array,
+	size_t size);
+
+#endif /* __REPORT_H__ */
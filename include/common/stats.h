@@ -27,6 +27,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include "export.h"
 #include "platform.h"
 
 /**
@@ -42,17 +43,16 @@
  * @return: void
  *
  */
-void print_array(uint8_t * array, size_t size);
+EMBEDDED_API void print_array(uint8_t * array, size_t size);
 
 /**
  * @brief: Reorders the given one-dimentional array from large to small. 
  *
  * Reorders the given one-dimentional array of unsigned char elements
- * from large to small. Uses selection sort (Θ(n2)), because the given
- * array is not too large and its size is predefined. Inspite of
- * quadratic time efficiency, which is not effective for large arrays,
- * selection sort is simple and has a good space efficiency
- * (O(1) auxiliary), which is important for embedded apps.
+ * from large to small. Uses counting sort (Θ(n)) with a 256-entry
+ * histogram: every value is rewritten from the histogram, so no
+ * auxiliary copy of the array is needed, which is important for
+ * embedded apps. Short arrays are insertion sorted.
  *
  * @param: unsigned char * array The pointer to the first element of
  *								 unsigned char array to reorder
@@ -60,7 +60,7 @@ void print_array(uint8_t * array, size_t size);
  * @return: void
  *
  */
-void sort_array(uint8_t * array, size_t size);
+EMBEDDED_API void sort_array(uint8_t * array, size_t size);
 
 /**
  * @brief: Finds the biggest element in the given array.
@@ -74,7 +74,7 @@ void sort_array(uint8_t * array, size_t size);
  * @return: unsigned char The biggest unsigned char element
  *
  */
-uint8_t find_maximum(uint8_t * array, size_t size);
+EMBEDDED_API uint8_t find_maximum(uint8_t * array, size_t size);
 
 /**
  * @brief: Finds the smallest element in the given array.
@@ -88,22 +88,42 @@ uint8_t find_maximum(uint8_t * array, size_t size);
  * @return: unsigned char The smallest unsigned char element
  *
  */
-uint8_t find_minimum(uint8_t * array, size_t size);
+EMBEDDED_API uint8_t find_minimum(uint8_t * array, size_t size);
 
 /**
  * @brief: Calculates the median of the given array.
  *
  * Calculates the median of the given one-dimentional array of unsigned
- * char data items.
+ * char data items. The array does not need to be sorted: the middle
+ * element is found with select_nth(), which partially reorders the
+ * array in place. For an even number of elements the two middle values
+ * are averaged without overflow.
  *
  * @param: unsigned char * array The pointer to the first element of
  *								 unsigned char array to analyze
  * @param: int size The number of elements in the array
- * @return: unsigned short The median value, which can be stored in
- *						   unsigned short type.
+ * @return: unsigned char The median value, 0 for an empty array
  *
  */
-uint8_t find_median(uint8_t * array, size_t size);
+EMBEDDED_API uint8_t find_median(uint8_t * array, size_t size);
+
+/**
+ * @brief: Finds the p-th percentile of the given array.
+ *
+ * Finds the p-th percentile of the given one-dimentional array of
+ * unsigned char data items with the nearest-rank method: the result is
+ * the ceil(p * size / 100)-th smallest element (the smallest one for
+ * p = 0). Runs in expected O(n) time and partially reorders the array
+ * in place.
+ *
+ * @param: unsigned char * array The pointer to the first element of
+ *								 unsigned char array to analyze
+ * @param: int size The number of elements in the array
+ * @param: unsigned char p The percentile to find, from 0 to 100
+ * @return: unsigned char The percentile value, 0 for an empty array
+ *
+ */
+EMBEDDED_API uint8_t find_percentile(uint8_t * array, size_t size, uint8_t p);
 
 /**
  * @brief: Calculates the mean of the given array.
@@ -117,7 +137,7 @@ uint8_t find_median(uint8_t * array, size_t size);
  * @return: unsigned char The mean value
  *
  */
-uint8_t find_mean(uint8_t * array, size_t size);
+EMBEDDED_API uint8_t find_mean(uint8_t * array, size_t size);
 
 /**
  * @brief: Print statistics in a nicely format.
@@ -131,7 +151,50 @@ uint8_t find_mean(uint8_t * array, size_t size);
  * @return: void
  *
  */
-void print_statistics(uint8_t * array, size_t size);
+EMBEDDED_API void print_statistics(uint8_t * array, size_t size);
+
+/**
+ * @brief: Element type specific statistics.
+ *
+ * Every function above has a typed twin named <function>_<sfx>, which
+ * takes an array of the given element type and returns that type:
+ * print_array, sort_array, find_maximum, find_minimum, find_median,
+ * find_percentile, find_mean and print_statistics. The functions above
+ * are the u8 instantiation. The algorithm is picked per element type at
+ * compile time: counting sort for u8, LSD radix sort for i16 (heap sort
+ * if no scratch memory can be reserved), in-place heap sort for i32 and
+ * f32, and a 4-lane SIMD reduction of maximum, minimum and mean for f32.
+ * On HOST, arrays of PSORT_MIN_SIZE elements or more are sorted by the
+ * parallel radix sort of psort.h instead.
+ * Sums are accumulated in a wider type, so the mean does not overflow.
+ *
+ * select_nth_<sfx>(array, size, k) reorders the array in place so that
+ * array[k] holds the element which would be there if the array was sorted
+ * from small to large, all elements before it are not greater and all
+ * elements after it are not smaller (introselect, expected O(n), worst
+ * case O(n log n)).
+ *
+ * Instantiated for: u8 (uint8_t), i16 (int16_t), i32 (int32_t) and
+ * f32 (float).
+ *
+ */
+#define STATS_DECLARE(SFX, T)						\
+	EMBEDDED_API void print_array_##SFX(T * array, size_t size);	\
+	EMBEDDED_API void sort_array_##SFX(T * array, size_t size);	\
+	EMBEDDED_API T find_maximum_##SFX(T * array, size_t size);	\
+	EMBEDDED_API T find_minimum_##SFX(T * array, size_t size);	\
+	EMBEDDED_API void select_nth_##SFX(T * array, size_t size,	\
+		size_t k);						\
+	EMBEDDED_API T find_percentile_##SFX(T * array, size_t size,	\
+		uint8_t p);						\
+	EMBEDDED_API T find_median_##SFX(T * array, size_t size);	\
+	EMBEDDED_API T find_mean_##SFX(T * array, size_t size);		\
+	EMBEDDED_API void print_statistics_##SFX(T * array, size_t size);
+
+STATS_DECLARE(u8, uint8_t)
+STATS_DECLARE(i16, int16_t)
+STATS_DECLARE(i32, int32_t)
+STATS_DECLARE(f32, float)
 
 /**
  * @brief: Print statistics in a nicely format.
@@ -145,7 +208,7 @@ void print_statistics(uint8_t * array, size_t size);
  * @return: void
  *
  */
-void show_stats();
+EMBEDDED_API void show_stats();
 
 /**
  * @brief: Show input data and calculated statistics.
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file testrun.h
+ * @brief Table driven test runner
+ *
+ * Tests are registered in a table of struct testrun_test. The runner calls
+ * every test once per case: for each parameter of the test and for each
+ * alignment of its sweep. A fixture prepares the case before the test and
+ * cleans up after it, the runner times every case with timing_now().
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __TESTRUN_H__
+#define __TESTRUN_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define TESTRUN_PASS (0)
+#define TESTRUN_FAIL (1)
+
+/* Bytes after the end of a buffer fixture that tests may check */
+#define TESTRUN_GUARD (16)
+
+/**
+ * @brief State of one case
+ *
+ * param and align are the swept values of the case. buf and len are set
+ * up by the fixture, data is free for the fixture or the test.
+ */
+struct testrun_ctx {
+	int32_t param;
+	uint8_t align;
+	uint8_t *buf;
+	size_t len;
+	void *data;
+};
+
+/**
+ * @brief Setup and teardown of a case
+ *
+ * setup returns TESTRUN_PASS on success, a failed setup fails the case
+ * without calling the test and the teardown.
+ */
+struct testrun_fixture {
+	int8_t (*setup)(struct testrun_ctx *ctx);
+	void (*teardown)(struct testrun_ctx *ctx);
+};
+
+/**
+ * @brief One registered test
+ *
+ * params points to nparams values for ctx->param. With params NULL the
+ * test runs for ctx->param 0 ... nparams - 1, with nparams 0 it runs once
+ * for 0. aligns sweeps ctx->align over 0 ... aligns - 1, 0 runs once for 0.
+ * fixture may be NULL.
+ */
+struct testrun_test {
+	const char *name;
+	int8_t (*run)(struct testrun_ctx *ctx);
+	const struct testrun_fixture *fixture;
+	const int32_t *params;
+	uint16_t nparams;
+	uint8_t aligns;
+};
+
+/**
+ * @brief Totals of a test table
+ */
+struct testrun_result {
+	uint16_t tests;
+	uint16_t tests_failed;
+	uint32_t cases;
+	uint32_t cases_failed;
+	uint64_t ns;
+};
+
+/**
+ * @brief Byte buffer fixture
+ *
+ * Allocates a word aligned buffer of 4 * |param| + TESTRUN_GUARD bytes
+ * that starts at offset align, and fills byte i of it with (uint8_t)i.
+ */
+extern const struct testrun_fixture testrun_buffer;
+
+/**
+ * @brief Run a table of tests
+ *
+ * Prints one line per test with its number of cases, failures and the
+ * time per case, and the parameters of every failed case.
+ *
+ * @param tests Test table
+ * @param count Number of tests in the table
+ * @param result Totals, may be NULL
+ *
+ * @return Number of failed tests.
+ */
+uint16_t testrun(const struct testrun_test *tests, uint16_t count,
+	struct testrun_result *result);
+
+#define TESTRUN_ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
+
+#endif /* __TESTRUN_H__ */
@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are 
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material. 
+ *
+ *****************************************************************************/
+/**
+ * @file timing.h
+ * @brief Platform independent time stamps for benchmarks and tests
+ *
+ * This header file provides a free running time stamp counter. On HOST it
+ * is backed by the monotonic clock and counts nanoseconds, on MSP432 it is
+ * backed by the DWT cycle counter of the Cortex-M4 and counts core clock
+ * cycles.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __TIMING_H__
+#define __TIMING_H__
+
+#include <stdint.h>
+#include "export.h"
+
+/**
+ * @brief Read the time stamp counter
+ *
+ * Returns the current value of the free running time stamp counter. The
+ * first call on MSP432 enables the DWT cycle counter. The 32-bit hardware
+ * counter is extended to 64 bits, which requires at least one call per
+ * wrap around (89 s at 48 MHz).
+ *
+ * @return Current time stamp in ticks.
+ */
+EMBEDDED_API uint64_t timing_now(void);
+
+/**
+ * @brief Convert a number of ticks into nanoseconds
+ *
+ * Converts a difference of two timing_now() values into nanoseconds.
+ * On MSP432 this uses the current SystemCoreClock.
+ *
+ * @param ticks Number of ticks to convert
+ *
+ * @return The given time span in nanoseconds.
+ */
+EMBEDDED_API uint64_t timing_to_ns(uint64_t ticks);
+
+/**
+ * @brief Boot time
+ *
+ * Returns the core clock cycles from the start of Reset_Handler to the
+ * call of main(), counted by the DWT cycle counter. This is the
+ * initialization of the RAM sections at the reset clock (DCO, 3 MHz) and
+ * SystemInit(), which switches to __SYSTEM_CLOCK. MSP432 only, 0 on HOST.
+ *
+ * @param init If not NULL, receives the cycles of the RAM initialization
+ *
+ * @return Cycles from reset to main().
+ */
+EMBEDDED_API uint32_t timing_boot(uint32_t *init);
+
+#endif /* __TIMING_H__ */
@@ -0,0 +1,109 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file vectors.h
+ * @brief Interrupt vector table in SRAM with runtime handler registration
+ *
+ * vectors_init() copies interruptVectors[] from flash to the .vtable
+ * section at the start of SRAM and points VTOR at it. From then on
+ * vectors_set() installs or swaps the handler of an exception or an
+ * interrupt at runtime, instead of overriding the weak alias of
+ * Default_Handler at link time. The vector fetch of every exception entry
+ * reads SRAM, without the flash wait states.
+ *
+ * Interrupts are numbered like IRQn_Type of CMSIS: -14 (NMI) to -1
+ * (SysTick) for the system exceptions, 0 to VECTORS_IRQS - 1 for the
+ * device interrupts. The initial stack pointer and the reset vector
+ * cannot be changed.
+ *
+ * On HOST the table is a simulated one, vectors_dispatch() calls its
+ * handlers.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#ifndef __VECTORS_H__
+#define __VECTORS_H__
+
+#include <stdint.h>
+#include "export.h"
+
+/* Stack pointer, reset vector and the system exceptions */
+#define VECTORS_SYSTEM (16)
+/* Device interrupts, including the reserved ones */
+#define VECTORS_IRQS (64)
+#define VECTORS (VECTORS_SYSTEM + VECTORS_IRQS)
+
+/* Lowest interrupt number vectors_set() accepts, the NMI */
+#define VECTORS_FIRST (-14)
+
+typedef void (*vectors_handler)(void);
+
+/**
+ * @brief Move the vector table to SRAM
+ *
+ * Copies the flash table and sets VTOR with interrupts disabled. Calls
+ * after the first have no effect, vectors_set() calls it as well.
+ *
+ * @return void.
+ */
+EMBEDDED_API void vectors_init(void);
+
+/**
+ * @brief Install the handler of an interrupt
+ *
+ * The new handler takes the next exception entry. A swap of the handler
+ * of an enabled interrupt needs no locking, a vector is one word.
+ *
+ * @param irq Interrupt number, VECTORS_FIRST to VECTORS_IRQS - 1
+ * @param handler New handler, NULL for the one of the flash table
+ * @param old Previous handler, or NULL
+ *
+ * @return 0 or EINVAL for an interrupt number out of range.
+ */
+EMBEDDED_API int vectors_set(int irq, vectors_handler handler,
+	vectors_handler *old);
+
+/**
+ * @brief Current handler of an interrupt
+ *
+ * The one of the flash table before vectors_init().
+ *
+ * @param irq Interrupt number, VECTORS_FIRST to VECTORS_IRQS - 1
+ *
+ * @return The handler, NULL for an interrupt number out of range or a
+ * reserved vector.
+ */
+EMBEDDED_API vectors_handler vectors_get(int irq);
+
+#if defined (HOST)
+/**
+ * @brief Take a simulated interrupt
+ *
+ * Calls the handler of the simulated table.
+ *
+ * @param irq Interrupt number, VECTORS_FIRST to VECTORS_IRQS - 1
+ *
+ * @return 0 or EINVAL for an interrupt number out of range or a reserved
+ * vector.
+ */
+EMBEDDED_API int vectors_dispatch(int irq);
+
+/**
+ * @brief Number of simulated interrupts without an installed handler
+ *
+ * @return Calls of the default handler.
+ */
+EMBEDDED_API uint32_t vectors_unhandled(void);
+#endif
+
+#endif /* __VECTORS_H__ */
@@ -16,12 +16,84 @@ SOURCES := \
 	src/main.c \
 	src/memory.c \
 	src/data.c \
-	src/stats.c
+	src/stats.c \
+	src/report.c \
+	src/timing.c \
+	src/clock.c \
+	src/flash.c \
+	src/vectors.c \
+	src/fault.c \
+	src/log.c \
+	src/console.c
+
+ifneq ($(DEFERRED_LOG),)
+
+SOURCES += \
+	src/logbuf.c
+
+endif
 
 ifneq ($(COURSE1),)
 
 SOURCES += \
-	src/course1.c
+	src/course1.c \
+	src/testrun.c
+
+ifeq ($(PLATFORM),HOST)
+SOURCES += \
+	src/proptest.c
+endif
+
+endif
+
+ifneq ($(BENCH),)
+
+SOURCES += \
+	src/bench.c
+
+endif
+
+ifneq ($(PERF),)
+
+SOURCES += \
+	src/perf.c
+
+endif
+
+ifeq ($(PLATFORM),HOST)
+
+SOURCES += \
+	src/pstats.c \
+	src/psort.c
+
+endif
+
+# libembedded, see embedded.h
+LIB_SOURCES := \
+	src/embedded.c \
+	src/memory.c \
+	src/data.c \
+	src/stats.c \
+	src/report.c \
+	src/timing.c \
+	src/clock.c \
+	src/flash.c \
+	src/vectors.c \
+	src/fault.c \
+	src/log.c
+
+ifneq ($(DEFERRED_LOG),)
+
+LIB_SOURCES += \
+	src/logbuf.c
+
+endif
+
+ifeq ($(PLATFORM),HOST)
+
+LIB_SOURCES += \
+	src/pstats.c \
+	src/psort.c
 
 endif
 
@@ -36,4 +108,7 @@ SOURCES += \
 	src/system_msp432p401r.c \
 	src/startup_msp432p401r_gcc.c
 
+LIB_SOURCES += \
+	src/console.c
+
 endif
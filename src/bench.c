@@ -0,0 +1,260 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file bench.c
+ * @brief Benchmarks of the common modules.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include "bench.h"
+#include "flash.h"
+#include "memory.h"
+#include "platform.h"
+#include "stats.h"
+#include "timing.h"
+
+/* 32M samples, tens of millions like the offline captures */
+#define BENCH_SAMPLES (32UL * 1024 * 1024)
+
+static size_t bench_samples(size_t def) {
+	const char *env = getenv("BENCH_SAMPLES");
+	long n;
+
+	if (env != NULL && (n = strtol(env, NULL, 10)) > 0)
+		return (size_t)n;
+
+	return def;
+}
+
+/* xorshift32, the same pseudo random data set on every run */
+static uint32_t bench_random(uint32_t *state) {
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	return *state = x;
+}
+
+#if defined (HOST)
+#include <string.h>
+#include "pstats.h"
+
+static void bench_pstats(void) {
+	uint32_t seed = 2463534242UL;
+	size_t size = bench_samples(BENCH_SAMPLES);
+	unsigned max_threads = pstats_threads();
+	unsigned threads;
+	uint64_t start, base = 0, ns;
+	struct pstats st;
+	int16_t *samples;
+	int16_t median;
+	size_t i;
+
+	st.hist = NULL;
+	samples = (int16_t *)reserve_words((size * sizeof(int16_t) + 3)/4);
+	if (samples == NULL)
+		return;
+
+	/* 14-bit ADC samples */
+	for (i = 0; i < size; i++)
+		samples[i] = (int16_t)(bench_random(&seed) & 0x3FFF) - 0x2000;
+
+	PRINTF("bench_pstats(): %lu int16 samples\n", (unsigned long)size);
+	PRINTF("  threads      time, ms   speedup\n");
+	for (threads = 1; threads <= max_threads; threads++) {
+		start = timing_now();
+		if (pstats_collect_i16(&st, samples, size, threads))
+			break;
+		ns = timing_to_ns(timing_now() - start);
+		if (threads == 1)
+			base = ns;
+		PRINTF("  %7u %13.3f %9.2f\n", threads, ns/1e6, (double)base/ns);
+		if (threads < max_threads)
+			pstats_free(&st);
+	}
+
+	/* the single threaded path: selection and reductions from stats.c */
+	start = timing_now();
+	median = find_median_i16(samples, size);
+	find_maximum_i16(samples, size);
+	find_minimum_i16(samples, size);
+	find_mean_i16(samples, size);
+	ns = timing_to_ns(timing_now() - start);
+	PRINTF("  stats.c %12.3f %9.2f\n", ns/1e6, (double)base/ns);
+
+	if (st.hist != NULL) {
+		if (pstats_median(&st) != median)
+			PRINTF("ERROR: %s: median mismatch\n", __func__);
+		pstats_print(&st);
+		pstats_free(&st);
+	}
+	free_words((int32_t *)samples);
+}
+
+static int bench_cmp_i32(const void *a, const void *b) {
+	int32_t x = *(const int32_t *)a;
+	int32_t y = *(const int32_t *)b;
+
+	/* large to small, like sort_array() */
+	return (x < y) - (x > y);
+}
+
+static void bench_sort(void) {
+	const size_t sizes[] = { 1000, 1000000, 100000000 };
+	size_t limit = bench_samples((size_t)-1);
+	uint32_t seed = 2463534242UL;
+	uint64_t start, ns_qsort, ns_sort;
+	int32_t *array, *copy;
+	size_t i, n;
+
+	PRINTF("bench_sort(): int32, %u threads\n", pstats_threads());
+	PRINTF("     elements   qsort, ms  sort_array, ms   speedup\n");
+	for (n = 0; n < sizeof(sizes)/sizeof(sizes[0]); n++) {
+		if (sizes[n] > limit)
+			break;
+		array = malloc(sizes[n] * sizeof(int32_t));
+		copy = malloc(sizes[n] * sizeof(int32_t));
+		if (array == NULL || copy == NULL) {
+			PRINTF("  %lu elements: not enough memory\n",
+				(unsigned long)sizes[n]);
+			free(array);
+			free(copy);
+			break;
+		}
+		for (i = 0; i < sizes[n]; i++)
+			array[i] = (int32_t)bench_random(&seed);
+		memcpy(copy, array, sizes[n] * sizeof(int32_t));
+
+		start = timing_now();
+		qsort(copy, sizes[n], sizeof(int32_t), bench_cmp_i32);
+		ns_qsort = timing_to_ns(timing_now() - start);
+
+		start = timing_now();
+		sort_array_i32(array, sizes[n]);
+		ns_sort = timing_to_ns(timing_now() - start);
+
+		PRINTF("  %11lu %11.3f %15.3f %9.2f\n", (unsigned long)sizes[n],
+			ns_qsort/1e6, ns_sort/1e6, (double)ns_qsort/ns_sort);
+		if (memcmp(array, copy, sizes[n] * sizeof(int32_t)))
+			PRINTF("ERROR: %s: result differs from qsort\n", __func__);
+		free(array);
+		free(copy);
+	}
+}
+#endif
+
+#if defined (MSP432)
+#define BENCH_RAMFUNC_SIZE (1024)
+#define BENCH_RAMFUNC_RUNS (16)
+
+/* Fastest of BENCH_RAMFUNC_RUNS calls, in cycles */
+#define BENCH_BEST(best, call) do {					\
+		uint64_t start_;					\
+		unsigned run_;						\
+									\
+		for (best = UINT64_MAX, run_ = 0;			\
+			run_ < BENCH_RAMFUNC_RUNS; run_++) {		\
+			start_ = timing_now();				\
+			call;						\
+			start_ = timing_now() - start_;			\
+			if (start_ < best)				\
+				best = start_;				\
+		}							\
+	} while (0)
+
+static uint8_t bench_src[BENCH_RAMFUNC_SIZE];
+static uint8_t bench_dst[BENCH_RAMFUNC_SIZE];
+
+/* The loops of my_memcopy() and my_memset() built into flash, to compare
+ * with the RAMFUNC ones in SRAM_CODE
+ */
+__attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+static uint8_t *bench_memcopy_flash(uint8_t *src, uint8_t *dst,
+	size_t length) {
+	uint8_t *p = dst;
+
+	while(length--)
+		*p++ = *src++;
+
+	return dst;
+}
+
+__attribute__((noinline, optimize("no-tree-loop-distribute-patterns")))
+static uint8_t *bench_memset_flash(uint8_t *src, size_t length,
+	uint8_t value) {
+
+	while(length--)
+		*src++ = value;
+
+	return src;
+}
+
+/* The reset clock is the 3 MHz DCO, SystemInit() switches to
+ * SystemCoreClock
+ */
+static void bench_boot(void) {
+	uint32_t init, boot = timing_boot(&init);
+
+	PRINTF("bench_boot(): %lu cycles from reset to main() at %lu Hz\n",
+		(unsigned long)boot, (unsigned long)SystemCoreClock);
+	PRINTF("  RAM init   %10lu cycles %9lu us\n", (unsigned long)init,
+		(unsigned long)(init / 3));
+	PRINTF("  SystemInit %10lu cycles\n", (unsigned long)(boot - init));
+}
+
+static void bench_ramfunc(void) {
+	uint64_t flash, ram;
+
+	PRINTF("bench_ramfunc(): %u bytes, cycles per call at %lu Hz\n",
+		BENCH_RAMFUNC_SIZE, (unsigned long)SystemCoreClock);
+	PRINTF("  kernel          flash   ramfunc   speedup\n");
+
+	BENCH_BEST(flash, bench_memcopy_flash(bench_src, bench_dst,
+		BENCH_RAMFUNC_SIZE));
+	BENCH_BEST(ram, my_memcopy(bench_src, bench_dst, BENCH_RAMFUNC_SIZE));
+	PRINTF("  my_memcopy %10lu %9lu %9lu%%\n", (unsigned long)flash,
+		(unsigned long)ram, (unsigned long)(100 * flash / ram));
+
+	BENCH_BEST(flash, bench_memset_flash(bench_dst, BENCH_RAMFUNC_SIZE,
+		0x55));
+	BENCH_BEST(ram, my_memset(bench_dst, BENCH_RAMFUNC_SIZE, 0x55));
+	PRINTF("  my_memset  %10lu %9lu %9lu%%\n", (unsigned long)flash,
+		(unsigned long)ram, (unsigned long)(100 * flash / ram));
+}
+
+static void bench_flash(void) {
+	struct flash_config best;
+
+	if (flash_measure(&best) == 0 || flash_configure(&best))
+		return;
+	PRINTF("  fastest: %u wait states, bufi %u bufd %u\n", best.wait,
+		best.buffer & FLASH_BUFI ? 1 : 0,
+		best.buffer & FLASH_BUFD ? 1 : 0);
+}
+#endif
+
+void bench(void) {
+
+#if defined (HOST)
+	bench_pstats();
+	bench_sort();
+#elif defined (MSP432)
+	bench_boot();
+	bench_ramfunc();
+	bench_flash();
+#endif
+}
@@ -0,0 +1,248 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file clock.c
+ * @brief Runtime switching of the core clock and the power regulator
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "clock.h"
+#include "flash.h"
+#include "platform.h"
+
+/* DCO frequencies of SystemInit(), the DCO range and the VCORE level:
+ * VCORE0 runs up to 24 MHz. The wait states come from flash_min_wait().
+ */
+struct clock_level {
+	uint32_t hz;
+	uint8_t dcorsel;
+	uint8_t vcore;
+};
+
+static const struct clock_level clock_levels[] = {
+	{ 1500000, 0, 0 },
+	{ 3000000, 1, 0 },
+	{ 12000000, 3, 0 },
+	{ 24000000, 4, 0 },
+	{ 48000000, 5, 1 },
+};
+
+#define CLOCK_LEVELS (sizeof(clock_levels) / sizeof(clock_levels[0]))
+
+static struct {
+	clock_callback cb;
+	void *arg;
+} clock_callbacks[CLOCK_CALLBACKS];
+
+static const struct clock_level *clock_level(uint32_t hz) {
+	unsigned i;
+
+	for (i = 0; i < CLOCK_LEVELS; i++)
+		if (clock_levels[i].hz == hz)
+			return &clock_levels[i];
+
+	return NULL;
+}
+
+#if defined (MSP432)
+
+static void clock_hw_power(uint8_t regulator, uint8_t vcore) {
+	uint32_t amr = regulator == CLOCK_DCDC ?
+		(vcore ? PCM_CTL0_AMR_5 : PCM_CTL0_AMR_4) :
+		(vcore ? PCM_CTL0_AMR_1 : PCM_CTL0_AMR_0);
+
+	while (PCM->CTL1 & PCM_CTL1_PMR_BUSY);
+	PCM->CTL0 = PCM_CTL0_KEY_VAL | amr;
+	while (PCM->CTL1 & PCM_CTL1_PMR_BUSY);
+}
+
+static void clock_hw_dco(uint32_t hz) {
+
+	CS->KEY = CS_KEY_VAL;
+	CS->CTL0 = (uint32_t)clock_level(hz)->dcorsel << CS_CTL0_DCORSEL_OFS;
+	CS->KEY = 0;
+	SystemCoreClockUpdate();
+}
+
+void clock_get(struct clock_state *state) {
+	struct flash_config flash;
+	uint32_t cpm = (PCM->CTL0 & PCM_CTL0_CPM_MASK) >> PCM_CTL0_CPM_OFS;
+	uint32_t dcorsel = (CS->CTL0 & CS_CTL0_DCORSEL_MASK) >>
+		CS_CTL0_DCORSEL_OFS;
+	unsigned i;
+
+	state->hz = SystemCoreClock;
+	for (i = 0; i < CLOCK_LEVELS; i++)
+		if (clock_levels[i].dcorsel == dcorsel)
+			state->hz = clock_levels[i].hz;
+	state->regulator = cpm & 0x4 ? CLOCK_DCDC : CLOCK_LDO;
+	state->vcore = cpm & 0x1;
+	flash_get(&flash);
+	state->wait = flash.wait;
+}
+
+#else
+/******************************************************************************
+ HOST stand-in, the steps update a simulated state
+******************************************************************************/
+#ifndef __REGULATOR
+#define __REGULATOR (0)
+#endif
+
+static struct clock_state clock_sim;
+
+static void clock_hw_power(uint8_t regulator, uint8_t vcore) {
+
+	clock_sim.regulator = regulator;
+	clock_sim.vcore = vcore;
+}
+
+static void clock_hw_dco(uint32_t hz) {
+
+	clock_sim.hz = hz;
+	SystemCoreClock = hz;
+}
+
+void clock_get(struct clock_state *state) {
+	struct flash_config flash;
+
+	/* the profile of SystemInit() */
+	if (clock_sim.hz == 0 && clock_lookup(SystemCoreClock,
+		__REGULATOR ? CLOCK_DCDC : CLOCK_LDO, &clock_sim))
+		clock_lookup(3000000, CLOCK_LDO, &clock_sim);
+	*state = clock_sim;
+	flash_get(&flash);
+	state->wait = flash.wait;
+}
+
+#endif
+
+int clock_lookup(uint32_t hz, uint8_t regulator, struct clock_state *state) {
+	const struct clock_level *level = clock_level(hz);
+
+	if (level == NULL || regulator > CLOCK_DCDC)
+		return EINVAL;
+
+	state->hz = hz;
+	state->regulator = regulator;
+	state->vcore = level->vcore;
+	state->wait = flash_min_wait(hz, level->vcore);
+
+	return 0;
+}
+
+unsigned clock_plan(const struct clock_state *from,
+	const struct clock_state *to, struct clock_state *steps) {
+	struct clock_state cur = *from;
+	unsigned n = 0;
+
+	/* VCORE changes on the LDO only */
+	if (cur.vcore != to->vcore && cur.regulator != CLOCK_LDO) {
+		cur.regulator = CLOCK_LDO;
+		steps[n++] = cur;
+	}
+	/* up: voltage and wait states first */
+	if (cur.vcore < to->vcore) {
+		cur.vcore = to->vcore;
+		steps[n++] = cur;
+	}
+	if (cur.wait < to->wait) {
+		cur.wait = to->wait;
+		steps[n++] = cur;
+	}
+	if (cur.hz != to->hz) {
+		cur.hz = to->hz;
+		steps[n++] = cur;
+	}
+	/* down: after the clock */
+	if (cur.wait > to->wait) {
+		cur.wait = to->wait;
+		steps[n++] = cur;
+	}
+	if (cur.vcore > to->vcore) {
+		cur.vcore = to->vcore;
+		steps[n++] = cur;
+	}
+	if (cur.regulator != to->regulator) {
+		cur.regulator = to->regulator;
+		steps[n++] = cur;
+	}
+
+	return n;
+}
+
+static void clock_notify(enum clock_event event, uint32_t hz) {
+	unsigned i;
+
+	for (i = 0; i < CLOCK_CALLBACKS; i++)
+		if (clock_callbacks[i].cb != NULL)
+			clock_callbacks[i].cb(event, hz, clock_callbacks[i].arg);
+}
+
+int clock_set(uint32_t hz, uint8_t regulator) {
+	struct clock_state steps[CLOCK_MAX_STEPS];
+	struct clock_state cur, to;
+	unsigned i, n;
+
+	if (clock_lookup(hz, regulator, &to))
+		return EINVAL;
+	clock_get(&cur);
+	if ((n = clock_plan(&cur, &to, steps)) == 0)
+		return 0;
+
+	clock_notify(CLOCK_PRE_CHANGE, cur.hz);
+	for (i = 0; i < n; i++) {
+		if (steps[i].regulator != cur.regulator ||
+			steps[i].vcore != cur.vcore)
+			clock_hw_power(steps[i].regulator, steps[i].vcore);
+		else if (steps[i].wait != cur.wait)
+			flash_wait(steps[i].wait);
+		else
+			clock_hw_dco(steps[i].hz);
+		cur = steps[i];
+	}
+	clock_notify(CLOCK_POST_CHANGE, hz);
+
+	return 0;
+}
+
+int clock_register(clock_callback cb, void *arg) {
+	unsigned i;
+
+	for (i = 0; i < CLOCK_CALLBACKS; i++)
+		if (clock_callbacks[i].cb == cb && clock_callbacks[i].arg == arg)
+			return 0;
+	for (i = 0; i < CLOCK_CALLBACKS; i++) {
+		if (clock_callbacks[i].cb == NULL) {
+			clock_callbacks[i].cb = cb;
+			clock_callbacks[i].arg = arg;
+			return 0;
+		}
+	}
+
+	return ENOMEM;
+}
+
+void clock_unregister(clock_callback cb, void *arg) {
+	unsigned i;
+
+	for (i = 0; i < CLOCK_CALLBACKS; i++) {
+		if (clock_callbacks[i].cb == cb && clock_callbacks[i].arg == arg) {
+			clock_callbacks[i].cb = NULL;
+			clock_callbacks[i].arg = NULL;
+		}
+	}
+}
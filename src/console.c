@@ -0,0 +1,343 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file console.c
+ * @brief Double buffered, DMA driven console output
+ *
+ * console_fill is the buffer being filled, the other one is in flight
+ * while console_busy is set. A write to an idle console starts the
+ * transfer at once, the completion of a transfer starts the next one if
+ * the other buffer got data meanwhile.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#if defined (HOST)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "platform.h"
+#include "console.h"
+
+#if CONSOLE_BUF_SIZE > 1024
+#error "CONSOLE_BUF_SIZE must fit into one DMA cycle of 1024 transfers"
+#endif
+
+static uint8_t console_buf[2][CONSOLE_BUF_SIZE];
+static volatile size_t console_used[2];
+static volatile uint8_t console_fill;
+static volatile uint8_t console_busy;
+static volatile uint32_t console_lost;
+static uint8_t console_ready;
+
+static void console_start(const uint8_t *data, size_t len);
+
+#if defined (MSP432)
+/******************************************************************************
+ eUSCI_A0 UART, fed by DMA channel 0
+******************************************************************************/
+#include "clock.h"
+#include "logbuf.h"
+#include "vectors.h"
+
+extern uint32_t SystemCoreClock;
+
+#define CONSOLE_DMA_CH (0)
+/* DMA channel 0 source 1 is the eUSCI_A0 transmit request */
+#define CONSOLE_DMA_SRC (1)
+
+/* Fields of the channel control word */
+#define CONSOLE_DMA_DST_INC_NONE (3u << 30)
+#define CONSOLE_DMA_DST_SIZE_8 (0u << 28)
+#define CONSOLE_DMA_SRC_INC_8 (0u << 26)
+#define CONSOLE_DMA_SRC_SIZE_8 (0u << 24)
+#define CONSOLE_DMA_ARB_1 (0u << 14)
+#define CONSOLE_DMA_N_MINUS_1_OFS (4)
+#define CONSOLE_DMA_MODE_BASIC (1u)
+
+struct console_dma_entry {
+	const volatile void *src_end;
+	volatile void *dst_end;
+	uint32_t control;
+	uint32_t spare;
+};
+
+/* Primary and alternate structures of channels 0 to 7 */
+static struct console_dma_entry console_dma_table[16]
+	__attribute__((aligned(256)));
+
+#define CONSOLE_LOCK() uint32_t primask_ = __get_PRIMASK(); __disable_irq()
+#define CONSOLE_UNLOCK() __set_PRIMASK(primask_)
+
+/* SMCLK runs from the DCO like MCLK after SystemInit() and clock_set() */
+static void console_baud(uint32_t hz) {
+	uint32_t div = hz / CONSOLE_BAUD;
+
+	EUSCI_A0->CTLW0 = EUSCI_A_CTLW0_SWRST | EUSCI_A_CTLW0_SSEL__SMCLK;
+	if (div >= 16) {
+		EUSCI_A0->BRW = div / 16;
+		EUSCI_A0->MCTLW = ((div % 16) << EUSCI_A_MCTLW_BRF_OFS) |
+			EUSCI_A_MCTLW_OS16;
+	} else {
+		EUSCI_A0->BRW = div;
+		EUSCI_A0->MCTLW = 0;
+	}
+	EUSCI_A0->CTLW0 &= ~EUSCI_A_CTLW0_SWRST;
+}
+
+static void console_clock(enum clock_event event, uint32_t hz, void *arg);
+static void console_dma_isr(void);
+
+static void console_hw_init(void) {
+
+	/* P1.2 RXD and P1.3 TXD */
+	P1->SEL0 |= BIT2 | BIT3;
+	P1->SEL1 &= ~(BIT2 | BIT3);
+
+	console_baud(SystemCoreClock);
+	clock_register(console_clock, NULL);
+
+	DMA_Control->ENACLR = 1 << CONSOLE_DMA_CH;
+	DMA_Control->CFG = DMA_CFG_MASTEN;
+	DMA_Control->CTLBASE = (uint32_t)(uintptr_t)console_dma_table;
+	DMA_Channel->CH_SRCCFG[CONSOLE_DMA_CH] = CONSOLE_DMA_SRC;
+	DMA_Control->ALTCLR = 1 << CONSOLE_DMA_CH;
+	DMA_Control->USEBURSTCLR = 1 << CONSOLE_DMA_CH;
+	DMA_Control->REQMASKCLR = 1 << CONSOLE_DMA_CH;
+	DMA_Channel->INT1_SRCCFG = DMA_INT1_SRCCFG_EN | CONSOLE_DMA_CH;
+	vectors_set(DMA_INT1_IRQn, console_dma_isr, NULL);
+	NVIC_EnableIRQ(DMA_INT1_IRQn);
+}
+
+/* Called by console_dma_isr() through console_tx_done() */
+RAMFUNC static void console_start(const uint8_t *data, size_t len) {
+	struct console_dma_entry *entry = &console_dma_table[CONSOLE_DMA_CH];
+
+	entry->src_end = data + len - 1;
+	entry->dst_end = &EUSCI_A0->TXBUF;
+	entry->control = CONSOLE_DMA_DST_INC_NONE | CONSOLE_DMA_DST_SIZE_8 |
+		CONSOLE_DMA_SRC_INC_8 | CONSOLE_DMA_SRC_SIZE_8 |
+		CONSOLE_DMA_ARB_1 | ((len - 1) << CONSOLE_DMA_N_MINUS_1_OFS) |
+		CONSOLE_DMA_MODE_BASIC;
+	DMA_Control->ENASET = 1 << CONSOLE_DMA_CH;
+
+	/* TXIFG is already set, so the first byte needs a software trigger */
+	DMA_Channel->SW_CHTRIG = DMA_SW_CHTRIG_CH0;
+}
+
+static void console_poll(void) {
+}
+
+static void console_wait(void) {
+
+	for (;;) {
+		__disable_irq();
+		if (!console_busy)
+			break;
+		/* a pending interrupt still ends __WFI() with PRIMASK set */
+		__WFI();
+		__enable_irq();
+	}
+	__enable_irq();
+}
+
+/* The queue drains at the old baud rate, the next byte uses the new one */
+static void console_clock(enum clock_event event, uint32_t hz, void *arg) {
+
+	(void)arg;
+	if (event == CLOCK_PRE_CHANGE) {
+		console_wait();
+		while (EUSCI_A0->STATW & EUSCI_A_STATW_BUSY);
+	} else {
+		console_baud(hz);
+	}
+}
+
+#if defined (DEFERRED_LOG)
+/*
+ * Binary deferred log records go to the console as well. logbuf_flush() is
+ * an explicit drain point, so it sleeps for free space instead of dropping.
+ */
+void logbuf_sink(const void *data, size_t len) {
+
+	if (console_write(data, len) == 0 && len > 0) {
+		console_flush();
+		console_write(data, len);
+	}
+}
+#endif
+
+#else
+/******************************************************************************
+ HOST stand-in, the transfer completes when the UART would be done
+******************************************************************************/
+#include <time.h>
+#include <unistd.h>
+#include "timing.h"
+
+static int console_fd = 1;
+static const uint8_t *console_dma_data;
+static size_t console_dma_len;
+static uint64_t console_dma_end;
+
+#define CONSOLE_LOCK()
+#define CONSOLE_UNLOCK()
+
+static void console_hw_init(void) {
+}
+
+static void console_start(const uint8_t *data, size_t len) {
+
+	console_dma_data = data;
+	console_dma_len = len;
+	/* 10 bits per byte: start, 8 data and stop bit */
+	console_dma_end = timing_to_ns(timing_now()) +
+		(uint64_t)len * 10 * 1000000000 / CONSOLE_BAUD;
+}
+
+static void console_tx_done(void);
+
+static void console_poll(void) {
+	const uint8_t *data = console_dma_data;
+	size_t len = console_dma_len;
+	ssize_t ret;
+
+	if (!console_busy || timing_to_ns(timing_now()) < console_dma_end)
+		return;
+
+	while (len > 0 && (ret = write(console_fd, data, len)) > 0) {
+		data += ret;
+		len -= ret;
+	}
+	console_tx_done();
+}
+
+static void console_wait(void) {
+	struct timespec pause;
+	uint64_t now;
+
+	while (console_busy) {
+		now = timing_to_ns(timing_now());
+		if (now < console_dma_end) {
+			pause.tv_sec = (console_dma_end - now) / 1000000000;
+			pause.tv_nsec = (console_dma_end - now) % 1000000000;
+			nanosleep(&pause, NULL);
+		}
+		console_poll();
+	}
+}
+
+void console_set_fd(int fd) {
+
+	console_flush();
+	console_fd = fd;
+}
+
+#endif
+
+/* RAMFUNC like its callers, the DMA interrupt runs from SRAM_CODE */
+RAMFUNC static void console_kick(void) {
+	uint8_t buf = console_fill;
+
+	console_busy = 1;
+	console_fill = buf ^ 1;
+	console_used[buf ^ 1] = 0;
+	console_start(console_buf[buf], console_used[buf]);
+}
+
+/* End of a transfer, in the DMA interrupt handler on MSP432 */
+RAMFUNC static void console_tx_done(void) {
+
+	console_busy = 0;
+	if (console_used[console_fill])
+		console_kick();
+}
+
+#if defined (MSP432)
+/* Installed in the SRAM vector table by console_hw_init(), with
+ * console_tx_done(), console_kick() and console_start() it runs from
+ * SRAM_CODE
+ */
+RAMFUNC static void console_dma_isr(void) {
+
+	console_tx_done();
+}
+#endif
+
+void console_init(void) {
+
+	console_hw_init();
+	console_fill = 0;
+	console_used[0] = 0;
+	console_used[1] = 0;
+	console_busy = 0;
+	console_lost = 0;
+	console_ready = 1;
+}
+
+size_t console_write(const void *data, size_t len) {
+
+	if (!console_ready)
+		console_init();
+	console_poll();
+
+	CONSOLE_LOCK();
+	if (console_used[console_fill] + len > CONSOLE_BUF_SIZE) {
+		console_lost += len;
+		len = 0;
+	} else {
+		memcpy(console_buf[console_fill] + console_used[console_fill],
+			data, len);
+		console_used[console_fill] += len;
+		if (!console_busy)
+			console_kick();
+	}
+	CONSOLE_UNLOCK();
+
+	return len;
+}
+
+/* Formatting stays out of CONSOLE_LOCK(), only the copy disables the
+ * interrupts
+ */
+int console_printf(const char *fmt, ...) {
+	char line[CONSOLE_LINE_SIZE];
+	va_list args;
+	int len;
+
+	va_start(args, fmt);
+	len = vsnprintf(line, sizeof(line), fmt, args);
+	va_end(args);
+
+	if (len < 0)
+		return 0;
+	if ((size_t)len >= sizeof(line))
+		len = sizeof(line) - 1;
+
+	return console_write(line, len);
+}
+
+void console_flush(void) {
+
+	if (console_ready)
+		console_wait();
+}
+
+uint32_t console_dropped(void) {
+
+	return console_lost;
+}
@@ -17,320 +17,979 @@
  *
  */
 
+#if defined (HOST)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#define LOG_MODULE_LEVEL COURSE1_LOG_LEVEL
+
+#include <errno.h>
+#include <limits.h>
 #include <stdint.h>
+#include <string.h>
+#if defined (HOST)
+#include <pthread.h>
+#endif
+#include "clock.h"
+#include "console.h"
+#include "fault.h"
+#include "flash.h"
+#include "logbuf.h"
+#include "proptest.h"
 #include "course1.h"
-#include "platform.h"
+#include "log.h"
 #include "memory.h"
 #include "data.h"
+#include "report.h"
 #include "stats.h"
-
-
-int8_t test_data1() {
-
-	int32_t num = -4096;
+#include "testrun.h"
+#include "vectors.h"
+
+
+/* Values for the itoa/atoi round trips, including both ends of int32_t */
+static const int32_t data_values[] = {
+	-4096, 123456, 0, 1, -1, 15, -16, 255, 256, 65535, -65536,
+	INT32_MAX, INT32_MIN,
+};
+
+/* Lengths for the memory sweeps, around the word and line boundaries */
+static const int32_t mem_sizes[] = {
+	1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65,
+	127, 128, 129, 255, 256, 257, 1000, 1024,
+};
+
+/* Lengths for my_reverse(), including the empty one and odd middles */
+static const int32_t reverse_sizes[] = {
+	0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 63, 64, 65,
+	127, 128, 129, 255, 256, 257, 511, 512, 513, 1000, 1024,
+};
+
+static int8_t data_round_trip(int32_t num, uint32_t base) {
+	uint8_t ptr[DATA_SET_SIZE_W * 4];
 	uint32_t digits;
 	int32_t value;
-	uint8_t *ptr;
 
-	PRINTF("\ntest_data1();\n");
-	ptr = (uint8_t*) reserve_words( DATA_SET_SIZE_W );
-
-	if (!ptr) {
+	digits = my_itoa(num, ptr, base);
+	value = my_atoi(ptr, digits, base);
+	if (value != num) {
+		LOG_DEBUG("  %ld in base %lu came back as %ld\n", (long)num,
+			(unsigned long)base, (long)value);
 		return TEST_ERROR;
 	}
 
-	digits = my_itoa( num, ptr, BASE_16);
-	value = my_atoi( ptr, digits, BASE_16);
+	return TEST_NO_ERROR;
+}
 
-	PRINTF("  Initial number: %d\n", num);
-	PRINTF("  Final Decimal number: %d\n", value);
+int8_t test_data1(struct testrun_ctx *ctx) {
 
-	free_words((int32_t*)ptr);
+	return data_round_trip(ctx->param, BASE_16);
+}
 
-	if ( value != num ) {
+int8_t test_data2(struct testrun_ctx *ctx) {
+
+	return data_round_trip(ctx->param, BASE_10);
+}
+
+int8_t test_data_sweep(struct testrun_ctx *ctx) {
+	/* multiplicative hashing spreads the case index over int32_t */
+	int32_t num = (int32_t)((uint32_t)ctx->param * 2654435761u);
+
+	if (data_round_trip(num, BASE_2) || data_round_trip(num, BASE_10) ||
+		data_round_trip(num, BASE_16)) {
 		return TEST_ERROR;
 	}
 
 	return TEST_NO_ERROR;
 }
 
-int8_t test_data2() {
+/*
+ * Checks a buffer set up by testrun_buffer after length bytes moved from
+ * offset src to offset dst: the destination holds the source pattern, all
+ * other bytes including the guard are untouched.
+ */
+static int8_t check_move(struct testrun_ctx *ctx, size_t src, size_t dst,
+	size_t length) {
+	uint8_t expect;
+	size_t i;
+
+	for (i = 0; i < ctx->len; i++) {
+		expect = (i >= dst && i < dst + length) ?
+			(uint8_t)(src + i - dst) : (uint8_t)i;
+		if (ctx->buf[i] != expect) {
+			return TEST_ERROR;
+		}
+	}
+
+	return TEST_NO_ERROR;
+}
+
+int8_t test_memmove1(struct testrun_ctx *ctx) {
+	size_t length = ctx->param;
 
-	int32_t num = 123456;
-	uint32_t digits;
-	int32_t value;
-	uint8_t *ptr;
+	my_memmove(ctx->buf, ctx->buf + length, length);
 
-	PRINTF("test_data2():\n");
-	ptr = (uint8_t*) reserve_words( DATA_SET_SIZE_W );
+	return check_move(ctx, 0, length, length);
+}
 
-	if (! ptr ) {
-		return TEST_ERROR;
-	}
+int8_t test_memmove2(struct testrun_ctx *ctx) {
+	size_t length = ctx->param;
+	size_t shift = (length + 1) / 2;
+
+	my_memmove(ctx->buf, ctx->buf + shift, length);
 
-	digits = my_itoa( num, ptr, BASE_10);
-	value = my_atoi( ptr, digits, BASE_10);
+	return check_move(ctx, 0, shift, length);
+}
 
-	PRINTF("  Initial Decimal number: %d\n", num);
-	PRINTF("  Final Decimal number: %d\n", value);
+int8_t test_memmove3(struct testrun_ctx *ctx) {
+	size_t length = ctx->param;
+	size_t shift = (length + 1) / 2;
 
-	free_words((int32_t*)ptr);
+	my_memmove(ctx->buf + shift, ctx->buf, length);
 
-	if ( value != num ) {
-		return TEST_ERROR;
+	return check_move(ctx, shift, 0, length);
+}
+
+int8_t test_memcopy(struct testrun_ctx *ctx) {
+	size_t length = ctx->param;
+
+	my_memcopy(ctx->buf, ctx->buf + length, length);
+
+	return check_move(ctx, 0, length, length);
+}
+
+int8_t test_memset(struct testrun_ctx *ctx)
+{
+	size_t length = ctx->param;
+	uint8_t expect;
+	size_t i;
+
+	my_memset(ctx->buf, length, 0xFF);
+	my_memzero(ctx->buf + length, length);
+
+	/* Validate Set & Zero Functionality, the rest is untouched */
+	for (i = 0; i < ctx->len; i++) {
+		expect = i < length ? 0xFF : i < 2 * length ? 0 : (uint8_t)i;
+		if (ctx->buf[i] != expect) {
+			return TEST_ERROR;
+		}
 	}
 
 	return TEST_NO_ERROR;
 }
 
-int8_t test_memmove1() {
+int8_t test_reverse(struct testrun_ctx *ctx)
+{
+	size_t length = ctx->param;
+	uint8_t expect;
+	size_t i;
+
+	my_reverse(ctx->buf, length);
 
+	for (i = 0; i < ctx->len; i++) {
+		expect = i < length ? (uint8_t)(length - i - 1) : (uint8_t)i;
+		if (ctx->buf[i] != expect) {
+			return TEST_ERROR;
+		}
+	}
+
+	return TEST_NO_ERROR;
+}
+
+int8_t test_percentile(struct testrun_ctx *ctx)
+{
 	uint8_t i;
 	int8_t ret = TEST_NO_ERROR;
 	uint8_t *set;
-	uint8_t *ptra;
-	uint8_t *ptrb;
-
-	PRINTF("test_memmove1() - NO OVERLAP\n");
-	set = (uint8_t*) reserve_words( MEM_SET_SIZE_W ); // 8
+	uint8_t *sorted;
+	int32_t wide[MEM_SET_SIZE_B];
+	float real[MEM_SET_SIZE_B];
 
-	if (! set ) {
+	set = (uint8_t*)reserve_words(MEM_SET_SIZE_W);
+	sorted = (uint8_t*)reserve_words(MEM_SET_SIZE_W);
+	if (! set || ! sorted ) {
+		free_words((int32_t*)set);
+		free_words((int32_t*)sorted);
 		return TEST_ERROR;
 	}
 
-	ptra = &set[0];
-	ptrb = &set[16];
-
-	/* Initialize the set to test values */
+	/* Pseudo random set with duplicates, sorted copy as a reference */
 	for( i = 0; i < MEM_SET_SIZE_B; i++) {
-		set[i] = i;
+		sorted[i] = (uint8_t)(i * 37 + 11) % 23;
 	}
+	sort_array(sorted, MEM_SET_SIZE_B);
 
-	print_array(set, MEM_SET_SIZE_B);
-	my_memmove(ptra, ptrb, TEST_MEMMOVE_LENGTH);
-	print_array(set, MEM_SET_SIZE_B);
-
-	for (i = 0; i < TEST_MEMMOVE_LENGTH; i++) {
-		if (set[i + 16] != i) {
+	/* select_nth must agree with the sorted copy for every rank */
+	for (i = 0; i < MEM_SET_SIZE_B; i++) {
+		my_memcopy(sorted, set, MEM_SET_SIZE_B);
+		my_reverse(set + i, MEM_SET_SIZE_B - i);
+		select_nth_u8(set, MEM_SET_SIZE_B, i);
+		if (set[i] != sorted[MEM_SET_SIZE_B - i - 1]) {
 			ret = TEST_ERROR;
 		}
 	}
 
+	/* nearest-rank: p0 is the minimum, p100 the maximum */
+	my_memcopy(sorted, set, MEM_SET_SIZE_B);
+	if (find_percentile(set, MEM_SET_SIZE_B, 0) != sorted[MEM_SET_SIZE_B - 1] ||
+		find_percentile(set, MEM_SET_SIZE_B, 50) != sorted[16] ||
+		find_percentile(set, MEM_SET_SIZE_B, 95) != sorted[1] ||
+		find_percentile(set, MEM_SET_SIZE_B, 100) != sorted[0]) {
+		ret = TEST_ERROR;
+	}
+
+	/* Odd sizes return the middle element, even sizes average without
+	 * truncating the sum
+	 */
+	set[0] = 250; set[1] = 7; set[2] = 240;
+	if (find_median(set, 3) != 240) {
+		ret = TEST_ERROR;
+	}
+	set[0] = 250; set[1] = 240; set[2] = 7; set[3] = 255;
+	if (find_median(set, 4) != 245) {
+		ret = TEST_ERROR;
+	}
+
+	for (i = 0; i < MEM_SET_SIZE_B; i++) {
+		wide[i] = ((int32_t)sorted[i] - 11) * 100000;
+		real[i] = sorted[i] * -0.5f;
+	}
+	if (find_median_i32(wide, MEM_SET_SIZE_B) !=
+		(((int32_t)sorted[15] + sorted[16]) * 100000 / 2 - 1100000) ||
+		find_percentile_f32(real, MEM_SET_SIZE_B, 100) != sorted[31] * -0.5f) {
+		ret = TEST_ERROR;
+	}
+
 	free_words((int32_t*)set);
+	free_words((int32_t*)sorted);
+
 	return ret;
 }
 
-int8_t test_memmove2() {
-
-	uint8_t i;
+int8_t test_sort(struct testrun_ctx *ctx)
+{
+	uint16_t i;
 	int8_t ret = TEST_NO_ERROR;
-	uint8_t *set;
-	uint8_t *ptra;
-	uint8_t *ptrb;
+	int16_t *samples;
+	float real[MEM_SET_SIZE_B];
+	uint8_t set[MEM_SET_SIZE_B];
 
-	PRINTF("test_memmove2() -OVERLAP END OF SRC BEGINNING OF DST\n");
-	set = (uint8_t*) reserve_words(MEM_SET_SIZE_W);
-
-	if (! set ) {
+	samples = (int16_t*)reserve_words(DATA_SET_SIZE_W * MEM_SET_SIZE_W);
+	if (! samples ) {
 		return TEST_ERROR;
 	}
-	ptra = &set[0];
-	ptrb = &set[8];
 
-	/* Initialize the set to test values */
-	for( i = 0; i < MEM_SET_SIZE_B; i++) {
-		set[i] = i;
+	/* 14-bit signed samples, long enough to take the radix path */
+	for (i = 0; i < 2 * DATA_SET_SIZE_W * MEM_SET_SIZE_W; i++) {
+		samples[i] = (int16_t)((i * 7919) % 16384) - 8192;
+	}
+	sort_array_i16(samples, 2 * DATA_SET_SIZE_W * MEM_SET_SIZE_W);
+	for (i = 1; i < 2 * DATA_SET_SIZE_W * MEM_SET_SIZE_W; i++) {
+		if (samples[i - 1] < samples[i]) {
+			ret = TEST_ERROR;
+		}
 	}
 
-	print_array(set, MEM_SET_SIZE_B);
-	my_memmove(ptra, ptrb, TEST_MEMMOVE_LENGTH);
-	print_array(set, MEM_SET_SIZE_B);
-
-	for (i = 0; i < TEST_MEMMOVE_LENGTH; i++) {
-		if (set[i + 8] != i) {
+	for (i = 0; i < MEM_SET_SIZE_B; i++) {
+		set[i] = (uint8_t)(i * 97);
+		real[i] = (float)i - 15.5f;
+	}
+	sort_array(set, MEM_SET_SIZE_B);
+	for (i = 1; i < MEM_SET_SIZE_B; i++) {
+		if (set[i - 1] < set[i]) {
 			ret = TEST_ERROR;
 		}
 	}
 
-	free_words((int32_t*)set);
+	/* 32 * 255 overflows the old uint8_t sum */
+	my_memset(set, MEM_SET_SIZE_B, 0xFF);
+	if (find_mean(set, MEM_SET_SIZE_B) != 0xFF ||
+		find_maximum_f32(real, MEM_SET_SIZE_B) != 15.5f ||
+		find_minimum_f32(real, MEM_SET_SIZE_B) != -15.5f ||
+		find_mean_f32(real, MEM_SET_SIZE_B) != 0.0f) {
+		ret = TEST_ERROR;
+	}
+
+	free_words((int32_t*)samples);
 
 	return ret;
 }
 
-int8_t test_memmove3() {
+static int8_t report_equals(struct report *rp, const char *expected) {
+	uint8_t *ptr = rp->buf;
 
-	uint8_t i;
+	while (*expected && *ptr == (uint8_t)*expected) {
+		ptr++;
+		expected++;
+	}
+
+	return *expected == '\0' && *ptr == '\0' &&
+		(size_t)(ptr - rp->buf) == rp->len;
+}
+
+int8_t test_report(struct testrun_ctx *ctx)
+{
 	int8_t ret = TEST_NO_ERROR;
-	uint8_t *set;
-	uint8_t *ptra;
-	uint8_t *ptrb;
+	struct report rp;
+	uint8_t buf[MEM_SET_SIZE_B * 4];
+	uint8_t set[3] = { 5, 0, 250 };
+
+	report_init(&rp, buf, sizeof(buf));
+	report_array(&rp, set, 2);
+	if (!report_equals(&rp, "=============\n\ttest[0] = 5\t\ttest[1] = 0\t")) {
+		ret = TEST_ERROR;
+	}
 
-	PRINTF("test_memove3() - OVERLAP END OF DEST BEGINNING OF SRC\n");
-	set = (uint8_t*)reserve_words( MEM_SET_SIZE_W);
+	report_init(&rp, buf, sizeof(buf));
+	report_statistics(&rp, set, 3);
+	if (rp.truncated || !report_equals(&rp, "======================\n"
+		"  Maximum value = 250\n  Minimum value = 0\n  Median = 5\n"
+		"  Mean = 85\n======================\n")) {
+		ret = TEST_ERROR;
+	}
 
-	if (! set ) {
-		return TEST_ERROR;
+	/* Truncated output keeps the terminator inside the buffer */
+	report_init(&rp, buf, 8);
+	report_int(&rp, -4096, BASE_16);
+	if (!rp.truncated || !report_equals(&rp, "fffff00")) {
+		ret = TEST_ERROR;
 	}
-	ptra = &set[8];
-	ptrb = &set[0];
 
-	/* Initialize the set to test values */
-	for( i = 0; i < MEM_SET_SIZE_B; i++) {
-		set[i] = i;
+	return ret;
+}
+
+int8_t test_log_limit(struct testrun_ctx *ctx)
+{
+	int8_t ret = TEST_NO_ERROR;
+	struct log_limit lim = { 0 };
+	uint32_t suppressed, printed = 0, reported = 0;
+	uint8_t i;
+
+	/* the interval is long enough to never expire during the test */
+	for (i = 0; i < 100; i++) {
+		printed += log_limit_check(&lim, 60000, 10, &suppressed);
+		reported += suppressed;
+	}
+	if (printed != 10 || reported != 0 || lim.suppressed != 90) {
+		ret = TEST_ERROR;
 	}
 
-	print_array(set, MEM_SET_SIZE_B);
-	my_memmove(ptra, ptrb, TEST_MEMMOVE_LENGTH);
-	print_array(set, MEM_SET_SIZE_B);
+	/* an expired interval reports what was dropped */
+	lim.begin -= 60000;
+	if (!log_limit_check(&lim, 60000, 10, &suppressed) || suppressed != 90) {
+		ret = TEST_ERROR;
+	}
+
+	/* a call site is reported by log_limit_flush() once its interval has
+	 * expired, without another message of its own
+	 */
+	{
+		static struct log_limit site = { .file = __FILE__,
+			.line = __LINE__, .severity = LOG_LEVEL_TRACE };
+		uint8_t level = log_set_level(LOG_LEVEL_NONE);
 
-	for (i = 0; i < TEST_MEMMOVE_LENGTH; i++) {
-		if (set[i] != (i + 8)) {
+		for (i = 0; i < 100; i++) {
+			log_limit_check(&site, 60000, 10, &suppressed);
+		}
+		log_limit_flush(0);
+		if (!site.queued || site.suppressed != 90) {
 			ret = TEST_ERROR;
 		}
+		site.begin -= 60000;
+		log_limit_flush(0);
+		if (site.queued || site.suppressed != 0 || site.printed != 0) {
+			ret = TEST_ERROR;
+		}
+		log_set_level(level);
 	}
 
-	free_words((int32_t*)set);
+	return ret;
+}
+
+int8_t test_console(struct testrun_ctx *ctx)
+{
+	int8_t ret = TEST_NO_ERROR;
+#if defined (HOST)
+	static uint8_t set[CONSOLE_BUF_SIZE];
+	uint8_t back[2 * CONSOLE_BUF_SIZE + 1];
+	FILE *file = tmpfile();
+	size_t i;
+
+	if (file == NULL) {
+		return TEST_ERROR;
+	}
+	for (i = 0; i < CONSOLE_BUF_SIZE; i++) {
+		set[i] = 'a' + i % 26;
+	}
+
+	console_set_fd(fileno(file));
+	console_init();
+
+	/*
+	 * The first buffer goes out at once and takes ~90 ms at 115200 baud,
+	 * the second one is queued behind it and anything more is dropped.
+	 */
+	if (console_write(set, CONSOLE_BUF_SIZE) != CONSOLE_BUF_SIZE ||
+		console_write(set, CONSOLE_BUF_SIZE) != CONSOLE_BUF_SIZE ||
+		console_write("x", 1) != 0 || console_dropped() != 1 ||
+		console_printf("%c", 'x') != 0 || console_dropped() != 2) {
+		ret = TEST_ERROR;
+	}
+
+	console_flush();
+	rewind(file);
+	if (fread(back, 1, sizeof(back), file) != 2 * CONSOLE_BUF_SIZE) {
+		ret = TEST_ERROR;
+	}
+	for (i = 0; i < 2 * CONSOLE_BUF_SIZE; i++) {
+		if (back[i] != set[i % CONSOLE_BUF_SIZE]) {
+			ret = TEST_ERROR;
+		}
+	}
+
+	/* console_printf() queues its line into the emptied buffer */
+	fseek(file, 0, SEEK_END);
+	if (console_printf("%d %s\n", 42, "ok") != 6) {
+		ret = TEST_ERROR;
+	}
+	console_flush();
+	fseek(file, 2 * CONSOLE_BUF_SIZE, SEEK_SET);
+	if (fread(back, 1, sizeof(back), file) != 6 ||
+		memcmp(back, "42 ok\n", 6) != 0) {
+		ret = TEST_ERROR;
+	}
+
+	console_set_fd(fileno(stdout));
+	fclose(file);
+#endif
 
 	return ret;
 }
 
-int8_t test_memcopy() {
+#if defined (DEFERRED_LOG)
+#if defined (HOST)
+#define LOGBUF_PRODUCERS (4)
+#define LOGBUF_PUTS (4096)
 
-	uint8_t i;
+static const char logbuf_test_fmt[] = "%u %u\n";
+static uint32_t logbuf_running;
+
+static void *logbuf_producer(void *arg) {
+	uint32_t words[2] = { (uint32_t)(uintptr_t)arg, 0 };
+
+	for (words[1] = 0; words[1] < LOGBUF_PUTS; words[1]++) {
+		logbuf_put(logbuf_test_fmt, words, 2);
+	}
+	__atomic_fetch_sub(&logbuf_running, 1, __ATOMIC_RELEASE);
+
+	return NULL;
+}
+#endif
+
+int8_t test_logbuf(struct testrun_ctx *ctx)
+{
 	int8_t ret = TEST_NO_ERROR;
-	uint8_t *set;
-	uint8_t *ptra;
-	uint8_t *ptrb;
+#if defined (HOST)
+	pthread_t tid[LOGBUF_PRODUCERS];
+	uint32_t next[LOGBUF_PRODUCERS] = { 0 };
+	struct logbuf_record rec;
+	uint32_t i, got = 0, lost;
+	int done;
+
+	/* whatever DEFERRED_LOG has queued so far goes out first, records
+	 * it overwrote count as dropped before the test starts
+	 */
+	logbuf_flush();
+	lost = logbuf_dropped();
+
+	logbuf_running = LOGBUF_PRODUCERS;
+	for (i = 0; i < LOGBUF_PRODUCERS; i++) {
+		if (pthread_create(&tid[i], NULL, logbuf_producer,
+			(void *)(uintptr_t)i)) {
+			/* the started producers finish their puts */
+			while (i > 0) {
+				pthread_join(tid[--i], NULL);
+			}
+			while (logbuf_read(&rec));
+			return TEST_ERROR;
+		}
+	}
 
-	PRINTF("test_memcopy()\n");
-	set = (uint8_t*) reserve_words(MEM_SET_SIZE_W);
+	/*
+	 * The puts fit into the ring, so every record must arrive whole and
+	 * in the order of its producer while the producers race each other
+	 * and the reader.
+	 */
+	do {
+		done = __atomic_load_n(&logbuf_running, __ATOMIC_ACQUIRE) == 0;
+		while (logbuf_read(&rec)) {
+			if (rec.fmt != logbuf_test_fmt || rec.nwords != 2 ||
+				rec.words[0] >= LOGBUF_PRODUCERS ||
+				rec.words[1] != next[rec.words[0]]++) {
+				ret = TEST_ERROR;
+				break;
+			}
+			got++;
+		}
+	} while (!done && ret == TEST_NO_ERROR);
 
-	if (! set ) {
-		return TEST_ERROR;
+	for (i = 0; i < LOGBUF_PRODUCERS; i++) {
+		pthread_join(tid[i], NULL);
+	}
+	while (logbuf_read(&rec)) {
+		got++;
 	}
-	ptra = &set[0];
-	ptrb = &set[16];
+	if (got != LOGBUF_PRODUCERS * LOGBUF_PUTS || logbuf_dropped() != lost) {
+		ret = TEST_ERROR;
+	}
+#endif
 
-	/* Initialize the set to test values */
-	for( i = 0; i < MEM_SET_SIZE_B; i++) {
-		set[i] = i;
+	return ret;
+}
+
+int8_t test_logbuf_file(struct testrun_ctx *ctx)
+{
+	int8_t ret = TEST_NO_ERROR;
+#if defined (HOST)
+	static const char fmt[] = "batch %u\n";
+	const size_t header = 2 * sizeof(uint32_t) + sizeof(const char *);
+	FILE *file = tmpfile(), *prev;
+	struct logbuf_record rec;
+	uint8_t data[256];
+	char text[16], expect[16];
+	uint32_t word, markers = 0, batches = 0;
+	size_t len, pos;
+
+	if (file == NULL) {
+		return TEST_ERROR;
 	}
 
-	print_array(set, MEM_SET_SIZE_B);
-	my_memcopy(ptra, ptrb, TEST_MEMMOVE_LENGTH);
-	print_array(set, MEM_SET_SIZE_B);
+	/* the second flush must not truncate what the first one wrote */
+	prev = logbuf_set_file(file);
+	for (word = 1; word <= 2; word++) {
+		logbuf_put(fmt, &word, 1);
+		logbuf_flush();
+	}
+	logbuf_set_file(prev);
+
+	rewind(file);
+	len = fread(data, 1, sizeof(data), file);
+	fclose(file);
+
+	for (pos = 0; pos + header <= len; ) {
+		memcpy(&rec.seq, data + pos, sizeof(rec.seq));
+		memcpy(&rec.nwords, data + pos + 4, sizeof(rec.nwords));
+		memcpy(&rec.fmt, data + pos + 8, sizeof(rec.fmt));
+		pos += header;
+		if (rec.nwords > LOGBUF_MAX_WORDS ||
+			pos + rec.nwords * 4 > len) {
+			return TEST_ERROR;
+		}
+		memcpy(rec.words, data + pos, rec.nwords * 4);
+		pos += rec.nwords * 4;
 
-	for (i = 0; i < TEST_MEMMOVE_LENGTH; i++) {
-		if (set[i+16] != i) {
+		/* relocation marker of a flush */
+		if (rec.seq == 0) {
+			markers++;
+			continue;
+		}
+		batches++;
+		logbuf_format(text, sizeof(text), rec.fmt, &rec,
+			sizeof(void *), NULL);
+		snprintf(expect, sizeof(expect), fmt, (unsigned)batches);
+		if (rec.fmt != fmt || markers != batches ||
+			strcmp(text, expect) != 0) {
 			ret = TEST_ERROR;
 		}
 	}
-
-	free_words((int32_t*)set);
+	if (pos != len || batches != 2) {
+		ret = TEST_ERROR;
+	}
+#endif
 
 	return ret;
 }
+#endif
 
-int8_t test_memset()
+/* Limits of the datasheet, independent of the table of clock.c */
+static int8_t clock_valid(const struct clock_state *st)
 {
-	uint8_t i;
-	uint8_t ret = TEST_NO_ERROR;
-	uint8_t *set;
-	uint8_t *ptra;
-	uint8_t *ptrb;
+	if (st->hz > (st->vcore ? 48000000u : 24000000u)) {
+		return 0;
+	}
+	if (st->hz > (st->vcore ? 32000000u : 24000000u)) {
+		return st->wait >= 2;
+	}
+	if (st->hz > (st->vcore ? 16000000u : 12000000u)) {
+		return st->wait >= 1;
+	}
 
-	PRINTF("test_memset()\n");
-	set = (uint8_t*)reserve_words(MEM_SET_SIZE_W);
-	if (! set ) {
-		return TEST_ERROR;
+	return 1;
+}
+
+#if defined (HOST)
+struct clock_events {
+	uint32_t pre;
+	uint32_t post;
+	uint8_t count;
+};
+
+static void clock_record(enum clock_event event, uint32_t hz, void *arg)
+{
+	struct clock_events *ev = arg;
+
+	if (event == CLOCK_PRE_CHANGE) {
+		ev->pre = hz;
+	} else {
+		ev->post = hz;
 	}
-	ptra = &set[0];
-	ptrb = &set[16];
+	ev->count++;
+}
+#endif
 
-	/* Initialize the set to test values */
-	for( i = 0; i < MEM_SET_SIZE_B; i++) {
-		set[i] = i;
+int8_t test_clock(struct testrun_ctx *ctx)
+{
+	static const uint32_t hz[] = {
+		1500000, 3000000, 12000000, 24000000, 48000000
+	};
+	struct clock_state from, to, prev, steps[CLOCK_MAX_STEPS];
+	/* every pair of frequency and regulator */
+	uint8_t f = ctx->param % 10, t = ctx->param / 10;
+	uint8_t power, changed;
+	unsigned i, n;
+
+	if (clock_lookup(hz[f / 2], f % 2, &from) ||
+		clock_lookup(hz[t / 2], t % 2, &to) || !clock_valid(&from) ||
+		!clock_valid(&to)) {
+		return TEST_ERROR;
 	}
 
-	print_array(set, MEM_SET_SIZE_B);
-	my_memset(ptra, MEM_SET_SIZE_B, 0xFF);
-	print_array(set, MEM_SET_SIZE_B);
-	my_memzero(ptrb, MEM_ZERO_LENGTH);
-	print_array(set, MEM_SET_SIZE_B);
+	n = clock_plan(&from, &to, steps);
+	if (n > CLOCK_MAX_STEPS) {
+		return TEST_ERROR;
+	}
+	prev = from;
+	for (i = 0; i < n; i++) {
+		power = steps[i].regulator != prev.regulator ||
+			steps[i].vcore != prev.vcore;
+		changed = power + (steps[i].wait != prev.wait) +
+			(steps[i].hz != prev.hz);
+		/* VCORE changes on the LDO only, the regulator at one VCORE */
+		if (changed != 1 || !clock_valid(&steps[i]) ||
+			(steps[i].vcore != prev.vcore &&
+			(prev.regulator != CLOCK_LDO ||
+			steps[i].regulator != CLOCK_LDO)) ||
+			(steps[i].regulator != prev.regulator &&
+			steps[i].vcore != prev.vcore)) {
+			return TEST_ERROR;
+		}
+		prev = steps[i];
+	}
+	if (prev.hz != to.hz || prev.regulator != to.regulator ||
+		prev.vcore != to.vcore || prev.wait != to.wait) {
+		return TEST_ERROR;
+	}
 
-	/* Validate Set & Zero Functionality */
-	for (i = 0; i < MEM_ZERO_LENGTH; i++) {
-		if (set[i] != 0xFF) {
+#if defined (HOST)
+	/* the HOST stand-in applies the same steps */
+	{
+		struct clock_events ev = { 0, 0, 0 };
+		struct clock_state orig, now;
+		int8_t ret = TEST_NO_ERROR;
+
+		clock_get(&orig);
+		if (clock_set(from.hz, from.regulator) ||
+			clock_register(clock_record, &ev) ||
+			clock_set(to.hz, to.regulator)) {
+			ret = TEST_ERROR;
+		}
+		clock_get(&now);
+		if (now.hz != to.hz || now.regulator != to.regulator ||
+			now.vcore != to.vcore || now.wait != to.wait ||
+			SystemCoreClock != to.hz ||
+			ev.count != (n ? 2 : 0) ||
+			(n && (ev.pre != from.hz || ev.post != to.hz))) {
 			ret = TEST_ERROR;
 		}
-		if (set[16 + i] != 0) {
+		clock_unregister(clock_record, &ev);
+		if (clock_set(orig.hz, orig.regulator) ||
+			clock_set(1000000, CLOCK_LDO) != EINVAL) {
 			ret = TEST_ERROR;
 		}
+		return ret;
 	}
+#endif
 
-	free_words((int32_t*)set);
+	return TEST_NO_ERROR;
+}
+
+int8_t test_flash(struct testrun_ctx *ctx)
+{
+	static const uint32_t hz[] = {
+		1500000, 3000000, 12000000, 24000000, 48000000
+	};
+	struct flash_config orig, cfg, bad, now;
+	struct clock_state st, clk;
+	int8_t ret = TEST_NO_ERROR;
+
+	/* the profile of every clock runs safely, buffered with wait states */
+	if (clock_lookup(hz[ctx->param], CLOCK_LDO, &st)) {
+		return TEST_ERROR;
+	}
+	flash_profile(st.hz, st.vcore, &cfg);
+	st.wait = cfg.wait;
+	if (!clock_valid(&st) ||
+		cfg.buffer != (cfg.wait ? FLASH_BUFI | FLASH_BUFD : 0)) {
+		return TEST_ERROR;
+	}
+	if (cfg.wait > 0) {
+		st.wait--;
+		if (clock_valid(&st)) {
+			return TEST_ERROR;
+		}
+	}
+
+	flash_get(&orig);
+	clock_get(&clk);
+#if defined (HOST)
+	/* clock_set() applies the profile */
+	if (clock_set(st.hz, CLOCK_LDO)) {
+		return TEST_ERROR;
+	}
+	flash_get(&now);
+	if (now.wait != cfg.wait) {
+		ret = TEST_ERROR;
+	}
+#else
+	/* the current clock on MSP432 */
+	flash_profile(clk.hz, clk.vcore, &cfg);
+#endif
+
+	/* too few wait states, too many and unknown buffers */
+	bad = cfg;
+	bad.wait--;
+	if (cfg.wait > 0 && flash_configure(&bad) != EINVAL) {
+		ret = TEST_ERROR;
+	}
+	bad.wait = FLASH_MAX_WAIT + 1;
+	if (flash_configure(&bad) != EINVAL) {
+		ret = TEST_ERROR;
+	}
+	bad.wait = cfg.wait;
+	bad.buffer = 0x4;
+	if (flash_configure(&bad) != EINVAL) {
+		ret = TEST_ERROR;
+	}
+
+	/* one more wait state with the instruction buffer only */
+	cfg.wait++;
+	cfg.buffer = FLASH_BUFI;
+	if (flash_configure(&cfg)) {
+		ret = TEST_ERROR;
+	}
+	flash_get(&now);
+	if (now.wait != cfg.wait || now.buffer != cfg.buffer) {
+		ret = TEST_ERROR;
+	}
+
+#if defined (HOST)
+	if (clock_set(clk.hz, clk.regulator)) {
+		ret = TEST_ERROR;
+	}
+#endif
+	if (flash_configure(&orig)) {
+		ret = TEST_ERROR;
+	}
 
 	return ret;
 }
 
-int8_t test_reverse()
+#if defined (HOST)
+static uint32_t vectors_calls[2];
+
+static void vectors_first(void)
 {
-	uint8_t i;
-	int8_t ret = TEST_NO_ERROR;
-	uint8_t *copy;
-	uint8_t set[MEM_SET_SIZE_B] = {0x3F, 0x73, 0x72, 0x33, 0x54, 0x43,
-								   0x72, 0x26, 0x48, 0x63, 0x20, 0x66,
-								   0x6F, 0x00, 0x20, 0x33, 0x72, 0x75,
-								   0x74, 0x78, 0x21, 0x4D, 0x20, 0x40,
-								   0x20, 0x24, 0x7C, 0x20, 0x24, 0x69,
-								   0x68, 0x54};
-
-	PRINTF("test_reverse()\n");
-	copy = (uint8_t*)reserve_words(MEM_SET_SIZE_W);
-	if (! copy ) {
+	vectors_calls[0]++;
+}
+
+static void vectors_second(void)
+{
+	vectors_calls[1]++;
+}
+#endif
+
+int8_t test_vectors(struct testrun_ctx *ctx)
+{
+	int irq = (int)ctx->param + VECTORS_FIRST;
+
+	/* stack pointer, reset vector and past the last interrupt */
+	if (vectors_set(VECTORS_FIRST - 1, NULL, NULL) != EINVAL ||
+		vectors_set(VECTORS_IRQS, NULL, NULL) != EINVAL ||
+		vectors_get(VECTORS_FIRST - 1) != NULL ||
+		vectors_get(VECTORS_IRQS) != NULL) {
 		return TEST_ERROR;
 	}
 
-	my_memcopy(set, copy, MEM_SET_SIZE_B);
+#if defined (HOST)
+	/* register, swap and restore every vector of the simulated table */
+	{
+		vectors_handler orig = vectors_get(irq), old;
+		uint32_t unhandled = vectors_unhandled();
+		int8_t ret = TEST_NO_ERROR;
+
+		vectors_calls[0] = 0;
+		vectors_calls[1] = 0;
+		if (vectors_set(irq, vectors_first, &old) || old != orig ||
+			vectors_dispatch(irq) || vectors_calls[0] != 1) {
+			ret = TEST_ERROR;
+		}
+		if (vectors_set(irq, vectors_second, &old) ||
+			old != vectors_first || vectors_dispatch(irq) ||
+			vectors_calls[0] != 1 || vectors_calls[1] != 1) {
+			ret = TEST_ERROR;
+		}
+		if (vectors_set(irq, NULL, &old) || old != vectors_second ||
+			vectors_get(irq) != orig) {
+			ret = TEST_ERROR;
+		}
+		/* reserved vectors stay empty, the others are the default */
+		if (orig == NULL) {
+			if (vectors_dispatch(irq) != EINVAL) {
+				ret = TEST_ERROR;
+			}
+		} else if (vectors_dispatch(irq) ||
+			vectors_unhandled() != unhandled + 1) {
+			ret = TEST_ERROR;
+		}
+		return ret;
+	}
+#else
+	(void)irq;
 
-	print_array(set, MEM_SET_SIZE_B);
-	my_reverse(set, MEM_SET_SIZE_B);
-	print_array(set, MEM_SET_SIZE_B);
+	return TEST_NO_ERROR;
+#endif
+}
 
-	for (i = 0; i < MEM_SET_SIZE_B; i++) {
-		if (set[i] != copy[MEM_SET_SIZE_B - i - 1]) {
+int8_t test_fault(struct testrun_ctx *ctx)
+{
+	/* EXC_RETURN of a basic and of an FPU frame, xPSR with the padding */
+	static const uint32_t exc_return[] = {
+		0xFFFFFFF9, 0xFFFFFFF9, 0xFFFFFFE9, 0xFFFFFFF9
+	};
+	static const uint32_t xpsr[] = {
+		0x21000000, 0x21000200, 0x21000000, 0x21000000
+	};
+#if defined (HOST)
+	/* odd addresses in the flash of the simulated MSP432, HardFault */
+	const uint32_t code[2] = { 0x00001235, 0x0003FFFF };
+	const uint32_t exception = 3;
+#else
+	/* Thumb functions, thread mode */
+	const uint32_t code[2] = { (uint32_t)(uintptr_t)test_fault,
+		(uint32_t)(uintptr_t)course1 };
+	const uint32_t exception = 0;
+#endif
+	uint32_t stack[48] = { 0 };
+	struct fault_record rec;
+	unsigned frame = ctx->param == 2 ? 26 : 8, i;
+	uint32_t *sp = stack + frame + (xpsr[ctx->param] & 0x200 ? 1 : 0);
+	int8_t ret = TEST_NO_ERROR;
+
+	for (i = 0; i < 8; i++) {
+		stack[i] = 0x100 + i;
+	}
+	stack[7] = xpsr[ctx->param];
+	/* code addresses are odd and in flash, the padding is skipped */
+	stack[frame] = 0x00001001;
+	sp[0] = code[0];
+	sp[1] = 0x20001000;
+	sp[2] = 0x00002000;
+	sp[3] = code[1];
+	sp[4] = 0x00040001;
+
+	fault_save(ctx->param == 3 ? NULL : stack, exc_return[ctx->param],
+		stack + TESTRUN_ARRAY_SIZE(stack));
+	if (fault_get(&rec) || rec.exception != exception ||
+		rec.exc_return != exc_return[ctx->param]) {
+		ret = TEST_ERROR;
+	} else if (ctx->param == 3) {
+		/* a broken stack, no registers or trace */
+		if (rec.pc != 0 || rec.xpsr != 0 || rec.depth != 0) {
 			ret = TEST_ERROR;
 		}
+	} else if (rec.r0 != 0x100 || rec.r12 != 0x104 || rec.lr != 0x105 ||
+		rec.pc != 0x106 || rec.xpsr != xpsr[ctx->param] ||
+		rec.sp != (uint32_t)(uintptr_t)sp || rec.depth != 2 ||
+		rec.trace[0] != code[0] || rec.trace[1] != code[1]) {
+		ret = TEST_ERROR;
+	}
+
+	fault_clear();
+	if (fault_get(&rec) != ENOENT || fault_report()) {
+		ret = TEST_ERROR;
 	}
 
-	free_words((int32_t*)copy);
+	return ret;
+}
+
+int8_t test_property(struct testrun_ctx *ctx)
+{
+	int8_t ret = TEST_NO_ERROR;
+#if defined (HOST)
+	struct proptest_config cfg;
+
+	proptest_config(&cfg);
+	if (proptest_run(&cfg)) {
+		ret = TEST_ERROR;
+	}
+#endif
 
 	return ret;
 }
 
+#define COURSE1_TEST(name, fixture, params, aligns)				\
+	{ #name, name, fixture, params, TESTRUN_ARRAY_SIZE(params), aligns }
+
+static const struct testrun_test course1_tests[] = {
+	COURSE1_TEST(test_data1, NULL, data_values, 0),
+	COURSE1_TEST(test_data2, NULL, data_values, 0),
+	{ "test_data_sweep", test_data_sweep, NULL, NULL, 1000, 0 },
+	COURSE1_TEST(test_memmove1, &testrun_buffer, mem_sizes, 4),
+	COURSE1_TEST(test_memmove2, &testrun_buffer, mem_sizes, 4),
+	COURSE1_TEST(test_memmove3, &testrun_buffer, mem_sizes, 4),
+	COURSE1_TEST(test_memcopy, &testrun_buffer, mem_sizes, 4),
+	COURSE1_TEST(test_memset, &testrun_buffer, mem_sizes, 4),
+	COURSE1_TEST(test_reverse, &testrun_buffer, reverse_sizes, 4),
+	{ "test_percentile", test_percentile, NULL, NULL, 0, 0 },
+	{ "test_sort", test_sort, NULL, NULL, 0, 0 },
+	{ "test_report", test_report, NULL, NULL, 0, 0 },
+	{ "test_log_limit", test_log_limit, NULL, NULL, 0, 0 },
+	{ "test_console", test_console, NULL, NULL, 0, 0 },
+#if defined (DEFERRED_LOG)
+	{ "test_logbuf", test_logbuf, NULL, NULL, 0, 0 },
+	{ "test_logbuf_file", test_logbuf_file, NULL, NULL, 0, 0 },
+#endif
+	{ "test_clock", test_clock, NULL, NULL, 100, 0 },
+	{ "test_flash", test_flash, NULL, NULL, 5, 0 },
+	{ "test_vectors", test_vectors, NULL, NULL,
+		VECTORS_IRQS - VECTORS_FIRST, 0 },
+	{ "test_fault", test_fault, NULL, NULL, 4, 0 },
+	{ "test_property", test_property, NULL, NULL, 0, 0 },
+};
+
 uint8_t course1(void)
 {
-	uint8_t i;
-	int8_t failed = 0;
-	int8_t results[TESTCOUNT];
+	struct testrun_result result;
 
-	results[0] = test_data1();
-	results[1] = test_data2();
-	results[2] = test_memmove1();
-	results[3] = test_memmove2();
-	results[4] = test_memmove3();
-	results[5] = test_memcopy();
-	results[6] = test_memset();
-	results[7] = test_reverse();
+	testrun(course1_tests, TESTRUN_ARRAY_SIZE(course1_tests), &result);
 
-	for ( i = 0; i < TESTCOUNT; i++) {
-		failed += results[i];
-	}
 	PRINTF("--------------------------------\n");
 	PRINTF("Test Results:\n");
-	PRINTF("  PASSED: %d / %d\n", (TESTCOUNT - failed), TESTCOUNT);
-	PRINTF("  FAILED: %d / %d\n", failed, TESTCOUNT);
+	PRINTF("  PASSED: %d / %d\n", result.tests - result.tests_failed,
+		result.tests);
+	PRINTF("  FAILED: %d / %d\n", result.tests_failed, result.tests);
+	PRINTF("  Cases: %lu, failed %lu, %lu us\n",
+		(unsigned long)result.cases, (unsigned long)result.cases_failed,
+		(unsigned long)(result.ns / 1000));
 	PRINTF("--------------------------------\n");
 
-	return 0;
+	return result.tests_failed > UINT8_MAX ? UINT8_MAX : result.tests_failed;
 }
@@ -17,11 +17,12 @@
  *
  */
 
+#define LOG_MODULE_LEVEL DATA_LOG_LEVEL
+
 #include <errno.h>
-#include <limits.h>
 #include <stdint.h>
 #include "data.h"
-#include "platform.h"
+#include "log.h"
 #include "memory.h"
 
 #define BASE_2 (2)
@@ -35,23 +36,24 @@
 
 static void print_str(uint8_t * str, uint8_t len) {
 
-#ifdef VERBOSE
-	PRINTF("\t>>>'");
+#if LOG_ENABLED(TRACE)
+	LOG_TRACE("\t>>>'");
 	while(len) {
-		PRINTF("%c", *str);
+		LOG_TRACE("%c", *str);
 		str++;
 		len--;
 	}
-	PRINTF("'<<<\n");
+	LOG_TRACE("'<<<\n");
 #endif
 
 }
 
-static uint8_t * int_to_str(int32_t data, uint8_t * start, uint32_t base) {
+static uint8_t * int_to_str(uint32_t data, uint8_t * start, uint32_t base) {
 	uint8_t * str = start;
 	uint8_t i;
 
-	while (data) {
+	/* do-while, so that zero still gives one digit */
+	do {
 		i = data % base;
 		data /= base;
 		if (i < 10) {
@@ -61,7 +63,7 @@ static uint8_t * int_to_str(int32_t data, uint8_t * start, uint32_t base) {
 			*str = 'a' - 10 + i;
 			str++;
 		}
-	}
+	} while (data);
 
 	return str;
 }
@@ -69,41 +71,34 @@ static uint8_t * int_to_str(int32_t data, uint8_t * start, uint32_t base) {
 uint8_t my_itoa(int32_t data, uint8_t * ptr, uint32_t base) {
 	uint8_t start_str[MAX_LEN];
 	uint8_t negative;
+	uint32_t value;
 	uint8_t len;
 	uint8_t * str;
 
 	/* check base */
 	if ((base < BASE_2 || base > BASE_16) || (base == BASE_8)) {
-		PRINTF("ERROR: Invalid base! Supported bases are: %d, %d, %d\n",
-			BASE_2, BASE_10, BASE_16);
+		LOG_RATELIMITED(ERROR, "ERROR: Invalid base! Supported bases "
+			"are: %d, %d, %d\n", BASE_2, BASE_10, BASE_16);
 
 		return EINVAL;
 	}
 
+	/* binary and hexadecimal keep the two's complement bits, decimal
+	 * gets the magnitude, negated as unsigned so that INT32_MIN does
+	 * not overflow
+	 */
 	negative = data < 0 ? 1 : 0;
-	if (negative) {
-		data *= -1;
-		if (base != BASE_10) {
-			/* need to perform a two's complement to store it as
-			 * a negative:
-			 * 'UINT_MAX - data' - for flipping bits (this will be
-			 * one's complement), then '+ 1' as we need two's
-			 * complement
-			 */
-			data = UINT_MAX - data + 1;
-		}
-	}
+	value = (uint32_t)data;
+	if (negative && base == BASE_10)
+		value = 0u - value;
 
-#ifdef VERBOSE
-	PRINTF("\t%s: data=%d, radix=%d\n", __func__, data, base);
-#endif
+	LOG_TRACE("\t%s: data=%ld, radix=%lu\n", __func__, (long)data,
+		(unsigned long)base);
 
-	str = int_to_str(data, start_str, base);
+	str = int_to_str(value, start_str, base);
 	len = str - start_str;
 
-#ifdef VERBOSE
-	PRINTF("\t%s: len=%d\n", __func__, len);
-#endif
+	LOG_TRACE("\t%s: len=%d\n", __func__, len);
 
 	if (base == BASE_10 && negative) {
 		*str++ = '-';
@@ -113,39 +108,36 @@ uint8_t my_itoa(int32_t data, uint8_t * ptr, uint32_t base) {
 	*str++ = '\0';
 	my_memcopy(start_str, ptr, len++);
 
-#ifdef VERBOSE
-	PRINTF("\t%s: converted str:\n", __func__);
+	LOG_TRACE("\t%s: converted str:\n", __func__);
 	print_str(ptr, len);
-	PRINTF("\t%s: len=%d\n", __func__, len);
-#endif
+	LOG_TRACE("\t%s: len=%d\n", __func__, len);
 
 	return len;
 }
 
 int32_t my_atoi(uint8_t * str, uint8_t digits, uint32_t base) {
-	int32_t num = 0;
+	uint32_t num = 0;
 	size_t len;
-	uint8_t data;
+	uint8_t data = 0;
 	uint8_t i = 0;
 	uint8_t negative = 0;
 
 	/* check base */
 	if ((base < BASE_2 || base > BASE_16) || (base == BASE_8)) {
-		PRINTF("ERROR: Invalid base! Supported bases are: %d, %d, %d\n",
-			BASE_2, BASE_10, BASE_16);
+		LOG_RATELIMITED(ERROR, "ERROR: Invalid base! Supported bases "
+			"are: %d, %d, %d\n", BASE_2, BASE_10, BASE_16);
 
 		return EINVAL;
 	}
 	digits--; /* skip str termination '\0' */
 	len = digits;
 
-#ifdef VERBOSE
-	PRINTF("\t%s: given str from end to start:\n", __func__);
-#endif
+	LOG_TRACE("\t%s: given str from end to start:\n", __func__);
 	print_str(str, digits);
 
 	if (*str == '-' ) {
 		negative = 1;
+		digits--;
 		len--;
 		str++;
 	}
@@ -166,6 +158,11 @@ int32_t my_atoi(uint8_t * str, uint8_t digits, uint32_t base) {
 				case 'E': case 'e': data=14; break;
 				case 'F': case 'f': data=15; break;
 			}
+		} else {
+			LOG_RATELIMITED(ERROR, "ERROR: Invalid digit 0x%x!\n",
+				*(str + digits));
+
+			return EINVAL;
 		}
 		if (base == BASE_10 || base == BASE_2) {
 			num = base * num + data;
@@ -178,13 +175,16 @@ int32_t my_atoi(uint8_t * str, uint8_t digits, uint32_t base) {
 			// 1 << 4*needed_pow = pow(16, needed_pow)
 			// pow(8,3) = 1<<(3*3)
 			// pow(128,7) = 1<<(7*7)
-			num += data * (1 << (4 * i));
+			num += (uint32_t)data << (4 * i);
 			i++;
 		}
 	}
 
+	/* accumulated as unsigned, "-2147483648" does not fit int32_t
+	 * before the negation
+	 */
 	if (base == BASE_10 && negative )
-		num *= -1;
+		num = 0u - num;
 
-	return num;
+	return (int32_t)num;
 }
@@ -0,0 +1,224 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file fault.c
+ * @brief Crash context of faults, kept over the reset
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "fault.h"
+#include "platform.h"
+
+/* "FAUL" */
+#define FAULT_MAGIC (0x4641554Cu)
+
+/* EXC_RETURN bit 4 is clear when the frame holds the FPU registers too */
+#define FAULT_EXC_BASIC (1u << 4)
+#define FAULT_FRAME_WORDS (8)
+#define FAULT_FRAME_FP_WORDS (26)
+/* xPSR bit 9, the core added a word to align the stack to 8 bytes */
+#define FAULT_XPSR_ALIGN (1u << 9)
+
+static struct fault_record fault_rec NOINIT;
+
+#if defined (MSP432)
+
+#define FAULT_STR_(x) #x
+#define FAULT_STR(x) FAULT_STR_(x)
+
+/* Words of the stack of fault_capture(), the broken one is left alone */
+#define FAULT_STACK 64
+
+#define FAULT_SRAM_DATA (0x20000000u)
+
+extern void (* const interruptVectors[])(void);
+extern const uint8_t __etext[];
+extern const uint8_t __ramfunc_start__[];
+extern const uint8_t __ramfunc_end__[];
+
+uint32_t fault_stack[FAULT_STACK] __attribute__((used, aligned(8)));
+
+/* Thumb code in flash or in .ramfunc */
+static uint8_t fault_code(uint32_t addr) {
+
+	if (!(addr & 1))
+		return 0;
+	addr &= ~1u;
+
+	return addr < (uint32_t)(uintptr_t)__etext ||
+		(addr >= (uint32_t)(uintptr_t)__ramfunc_start__ &&
+		addr < (uint32_t)(uintptr_t)__ramfunc_end__);
+}
+
+static void fault_status(struct fault_record *rec) {
+
+	rec->exception = __get_IPSR() & 0x1FF;
+	rec->cfsr = SCB->CFSR;
+	rec->hfsr = SCB->HFSR;
+	rec->mmfar = SCB->MMFAR;
+	rec->bfar = SCB->BFAR;
+}
+
+/* Called by fault_entry() on fault_stack, the main stack ends at the
+ * initial stack pointer
+ */
+__attribute__((used, noreturn))
+void fault_capture(const uint32_t *frame, uint32_t exc_return) {
+	const uint32_t *stack_end =
+		(const uint32_t *)(uintptr_t)interruptVectors[0];
+
+	if ((uintptr_t)frame < FAULT_SRAM_DATA || ((uintptr_t)frame & 3) ||
+		frame + FAULT_FRAME_WORDS > stack_end)
+		frame = NULL;
+	fault_save(frame, exc_return, stack_end);
+	/* stop for an attached debugger before the state is gone */
+	if (CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk)
+		__BKPT(0);
+	NVIC_SystemReset();
+}
+
+__attribute__((naked))
+void fault_entry(void) {
+
+	__asm volatile("	tst	lr, #4\n"
+		"	ite	eq\n"
+		"	mrseq	r0, msp\n"
+		"	mrsne	r0, psp\n"
+		"	mov	r1, lr\n"
+		"	ldr	r2, =fault_stack + " FAULT_STR(FAULT_STACK) " * 4\n"
+		"	mov	sp, r2\n"
+		"	b	fault_capture\n");
+}
+
+#else
+/******************************************************************************
+ HOST stand-in, frames of a simulated MSP432
+******************************************************************************/
+/* End of MAIN_FLASH */
+#define FAULT_FLASH_END (0x00040000u)
+
+static uint8_t fault_code(uint32_t addr) {
+
+	return (addr & 1) && addr < FAULT_FLASH_END;
+}
+
+/* A HardFault without status bits */
+static void fault_status(struct fault_record *rec) {
+
+	rec->exception = 3;
+	rec->cfsr = 0;
+	rec->hfsr = 0;
+	rec->mmfar = 0;
+	rec->bfar = 0;
+}
+
+#endif
+
+static uint32_t fault_sum(const struct fault_record *rec) {
+	const uint32_t *word = (const uint32_t *)rec;
+	uint32_t sum = 0;
+	size_t i;
+
+	for (i = 0; i < offsetof(struct fault_record, check) / 4; i++)
+		sum = (sum << 1 | sum >> 31) ^ word[i];
+
+	return ~sum;
+}
+
+void fault_save(const uint32_t *frame, uint32_t exc_return,
+	const uint32_t *stack_end) {
+	struct fault_record *rec = &fault_rec;
+	const uint32_t *p;
+	unsigned n;
+
+	fault_status(rec);
+	rec->exc_return = exc_return;
+	rec->depth = 0;
+	if (frame == NULL) {
+		rec->r0 = rec->r1 = rec->r2 = rec->r3 = rec->r12 = 0;
+		rec->lr = rec->pc = rec->xpsr = rec->sp = 0;
+	} else {
+		rec->r0 = frame[0];
+		rec->r1 = frame[1];
+		rec->r2 = frame[2];
+		rec->r3 = frame[3];
+		rec->r12 = frame[4];
+		rec->lr = frame[5];
+		rec->pc = frame[6];
+		rec->xpsr = frame[7];
+
+		p = frame + (exc_return & FAULT_EXC_BASIC ? FAULT_FRAME_WORDS :
+			FAULT_FRAME_FP_WORDS);
+		if (rec->xpsr & FAULT_XPSR_ALIGN)
+			p++;
+		rec->sp = (uint32_t)(uintptr_t)p;
+
+		for (n = 0; p < stack_end && n < FAULT_SCAN &&
+			rec->depth < FAULT_TRACE; p++, n++)
+			if (fault_code(*p))
+				rec->trace[rec->depth++] = *p;
+	}
+	for (n = rec->depth; n < FAULT_TRACE; n++)
+		rec->trace[n] = 0;
+
+	rec->magic = FAULT_MAGIC;
+	rec->check = fault_sum(rec);
+}
+
+int fault_get(struct fault_record *rec) {
+
+	if (fault_rec.magic != FAULT_MAGIC ||
+		fault_rec.check != fault_sum(&fault_rec) ||
+		fault_rec.depth > FAULT_TRACE)
+		return ENOENT;
+	*rec = fault_rec;
+
+	return 0;
+}
+
+void fault_clear(void) {
+
+	fault_rec.magic = 0;
+}
+
+uint8_t fault_report(void) {
+	struct fault_record rec;
+	unsigned i;
+
+	if (fault_get(&rec))
+		return 0;
+
+	PRINTF("fault: exception %lu\n", (unsigned long)rec.exception);
+	PRINTF("fault: pc 0x%08lx lr 0x%08lx sp 0x%08lx xpsr 0x%08lx\n",
+		(unsigned long)rec.pc, (unsigned long)rec.lr,
+		(unsigned long)rec.sp, (unsigned long)rec.xpsr);
+	PRINTF("fault: r0 0x%08lx r1 0x%08lx r2 0x%08lx r3 0x%08lx\n",
+		(unsigned long)rec.r0, (unsigned long)rec.r1,
+		(unsigned long)rec.r2, (unsigned long)rec.r3);
+	PRINTF("fault: r12 0x%08lx exc_return 0x%08lx\n",
+		(unsigned long)rec.r12, (unsigned long)rec.exc_return);
+	PRINTF("fault: cfsr 0x%08lx hfsr 0x%08lx mmfar 0x%08lx bfar 0x%08lx\n",
+		(unsigned long)rec.cfsr, (unsigned long)rec.hfsr,
+		(unsigned long)rec.mmfar, (unsigned long)rec.bfar);
+	PRINTF("fault: trace");
+	for (i = 0; i < rec.depth; i++)
+		PRINTF(" 0x%08lx", (unsigned long)rec.trace[i]);
+	PRINTF("\n");
+
+	fault_clear();
+
+	return 1;
+}
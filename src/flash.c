@@ -0,0 +1,226 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file flash.c
+ * @brief Wait states and read buffering of the flash controller
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "clock.h"
+#include "flash.h"
+#include "memory.h"
+#include "platform.h"
+#include "stats.h"
+#include "timing.h"
+
+#if defined (MSP432)
+
+static void flash_hw_set(const struct flash_config *cfg) {
+	uint32_t rdctl = (uint32_t)cfg->wait << FLCTL_BANK0_RDCTL_WAIT_OFS;
+
+	if (cfg->buffer & FLASH_BUFI)
+		rdctl |= FLCTL_BANK0_RDCTL_BUFI;
+	if (cfg->buffer & FLASH_BUFD)
+		rdctl |= FLCTL_BANK0_RDCTL_BUFD;
+
+	/* bank 1 has the same layout */
+	FLCTL->BANK0_RDCTL = (FLCTL->BANK0_RDCTL &
+		~(FLCTL_BANK0_RDCTL_WAIT_MASK | FLCTL_BANK0_RDCTL_BUFI |
+		FLCTL_BANK0_RDCTL_BUFD)) | rdctl;
+	FLCTL->BANK1_RDCTL = (FLCTL->BANK1_RDCTL &
+		~(FLCTL_BANK1_RDCTL_WAIT_MASK | FLCTL_BANK1_RDCTL_BUFI |
+		FLCTL_BANK1_RDCTL_BUFD)) | rdctl;
+}
+
+void flash_get(struct flash_config *cfg) {
+	uint32_t rdctl = FLCTL->BANK0_RDCTL;
+
+	cfg->wait = (rdctl & FLCTL_BANK0_RDCTL_WAIT_MASK) >>
+		FLCTL_BANK0_RDCTL_WAIT_OFS;
+	cfg->buffer = (rdctl & FLCTL_BANK0_RDCTL_BUFI ? FLASH_BUFI : 0) |
+		(rdctl & FLCTL_BANK0_RDCTL_BUFD ? FLASH_BUFD : 0);
+}
+
+#else
+/******************************************************************************
+ HOST stand-in, the configuration is a simulated state
+******************************************************************************/
+static struct flash_config flash_sim;
+static uint8_t flash_sim_ready;
+
+static void flash_hw_set(const struct flash_config *cfg) {
+
+	flash_sim = *cfg;
+	flash_sim_ready = 1;
+}
+
+void flash_get(struct flash_config *cfg) {
+
+	/* the profile of SystemInit(), 48 MHz runs on VCORE1 */
+	if (!flash_sim_ready) {
+		flash_profile(SystemCoreClock, SystemCoreClock > 24000000,
+			&flash_sim);
+		flash_sim_ready = 1;
+	}
+	*cfg = flash_sim;
+}
+
+#endif
+
+uint8_t flash_min_wait(uint32_t hz, uint8_t vcore) {
+
+	if (hz > (vcore ? 32000000u : 24000000u))
+		return 2;
+	if (hz > (vcore ? 16000000u : 12000000u))
+		return 1;
+
+	return 0;
+}
+
+void flash_profile(uint32_t hz, uint8_t vcore, struct flash_config *cfg) {
+
+	cfg->wait = flash_min_wait(hz, vcore);
+	cfg->buffer = cfg->wait ? FLASH_BUFI | FLASH_BUFD : 0;
+}
+
+int flash_configure(const struct flash_config *cfg) {
+	struct clock_state cur;
+
+	clock_get(&cur);
+	if (cfg->wait < flash_min_wait(cur.hz, cur.vcore) ||
+		cfg->wait > FLASH_MAX_WAIT ||
+		(cfg->buffer & ~(FLASH_BUFI | FLASH_BUFD)))
+		return EINVAL;
+
+	flash_hw_set(cfg);
+
+	return 0;
+}
+
+void flash_wait(uint8_t wait) {
+	struct flash_config cfg;
+
+	cfg.wait = wait;
+	cfg.buffer = wait ? FLASH_BUFI | FLASH_BUFD : 0;
+	flash_hw_set(&cfg);
+}
+
+/******************************************************************************
+ Measurement mode
+******************************************************************************/
+/* Kernel input, const so that it stays in flash */
+static const uint8_t flash_input[FLASH_MEASURE_SIZE] = {
+#define FLASH_INPUT_8(n) (uint8_t)((n) * 167 + 13), \
+	(uint8_t)((n + 1) * 167 + 13), (uint8_t)((n + 2) * 167 + 13), \
+	(uint8_t)((n + 3) * 167 + 13), (uint8_t)((n + 4) * 167 + 13), \
+	(uint8_t)((n + 5) * 167 + 13), (uint8_t)((n + 6) * 167 + 13), \
+	(uint8_t)((n + 7) * 167 + 13)
+#define FLASH_INPUT_32(n) FLASH_INPUT_8(n), FLASH_INPUT_8(n + 8), \
+	FLASH_INPUT_8(n + 16), FLASH_INPUT_8(n + 24)
+	FLASH_INPUT_32(0), FLASH_INPUT_32(32), FLASH_INPUT_32(64),
+	FLASH_INPUT_32(96), FLASH_INPUT_32(128), FLASH_INPUT_32(160),
+	FLASH_INPUT_32(192), FLASH_INPUT_32(224),
+#undef FLASH_INPUT_32
+#undef FLASH_INPUT_8
+};
+
+/* A copy for the kernels that modify their input */
+static uint8_t flash_work[FLASH_MEASURE_SIZE];
+
+/* my_memcopy() runs from SRAM and reads flash_input through the data
+ * path, sort_array() and find_median() are fetched from flash and work on
+ * the copy in SRAM
+ */
+enum flash_kernel {
+	FLASH_MEMCOPY,
+	FLASH_SORT,
+	FLASH_MEDIAN,
+	FLASH_KERNELS,
+};
+
+/* Fastest of FLASH_MEASURE_RUNS calls, in ns */
+static uint64_t flash_time(enum flash_kernel kernel) {
+	uint64_t best = UINT64_MAX, start;
+	unsigned run;
+
+	for (run = 0; run < FLASH_MEASURE_RUNS; run++) {
+		my_memcopy((uint8_t *)flash_input, flash_work,
+			FLASH_MEASURE_SIZE);
+		start = timing_now();
+		switch (kernel) {
+		case FLASH_MEMCOPY:
+			my_memcopy((uint8_t *)flash_input, flash_work,
+				FLASH_MEASURE_SIZE);
+			break;
+		case FLASH_SORT:
+			sort_array(flash_work, FLASH_MEASURE_SIZE);
+			break;
+		default:
+			find_median(flash_work, FLASH_MEASURE_SIZE);
+			break;
+		}
+		start = timing_now() - start;
+		if (start < best)
+			best = start;
+	}
+
+	return timing_to_ns(best);
+}
+
+unsigned flash_measure(struct flash_config *best) {
+	static const uint8_t buffers[] = {
+		0, FLASH_BUFI, FLASH_BUFD, FLASH_BUFI | FLASH_BUFD
+	};
+	struct flash_config orig, cfg;
+	struct clock_state cur;
+	uint64_t ns, total, best_total = UINT64_MAX;
+	unsigned i, k, n = 0;
+
+	clock_get(&cur);
+	flash_get(&orig);
+	*best = orig;
+
+	PRINTF("flash_measure(): %u bytes, ns per call at %lu Hz\n",
+		FLASH_MEASURE_SIZE, (unsigned long)cur.hz);
+	PRINTF("  wait bufi bufd   memcopy      sort    median     total\n");
+
+	for (cfg.wait = flash_min_wait(cur.hz, cur.vcore);
+		cfg.wait <= flash_min_wait(cur.hz, cur.vcore) + 1; cfg.wait++) {
+		for (i = 0; i < sizeof(buffers); i++) {
+			cfg.buffer = buffers[i];
+			if (flash_configure(&cfg))
+				continue;
+			PRINTF("  %4u %4u %4u", cfg.wait,
+				cfg.buffer & FLASH_BUFI ? 1 : 0,
+				cfg.buffer & FLASH_BUFD ? 1 : 0);
+			for (total = 0, k = 0; k < FLASH_KERNELS; k++) {
+				ns = flash_time((enum flash_kernel)k);
+				total += ns;
+				PRINTF(" %9lu", (unsigned long)ns);
+			}
+			PRINTF(" %9lu\n", (unsigned long)total);
+			if (total < best_total) {
+				best_total = total;
+				*best = cfg;
+			}
+			n++;
+		}
+	}
+
+	flash_hw_set(&orig);
+
+	return n;
+}
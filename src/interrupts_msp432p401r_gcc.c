@@ -56,76 +56,105 @@ extern void SystemInit(void);
 /* actions (such as making decisions based on the reset cause register, and    */
 /* resetting the bits in that register) are left solely in the hands of the    */
 /* application.                                                                */
-extern uint32_t __data_load__;
-extern uint32_t __data_start__;
-extern uint32_t __data_end__;
+/* Entries of the copy and zero tables of msp432p401r.lds                    */
+struct copy_table {
+    const uint32_t *src;
+    uint32_t *dst;
+    uint32_t words;
+};
+
+struct zero_table {
+    uint32_t *dst;
+    uint32_t words;
+};
+
+extern const struct copy_table __copy_table_start__[];
+extern const struct copy_table __copy_table_end__[];
+extern const struct zero_table __zero_table_start__[];
+extern const struct zero_table __zero_table_end__[];
+
+/* Cycles of the RAM initialization and of the whole boot, see timing.h     */
+extern uint32_t timing_boot_init;
+extern uint32_t timing_boot_main;
 
 #ifndef HWREG
 #define HWREG(x) (*((volatile uint32_t *)(x)))
 #endif
 
+#define DEMCR           0xE000EDFC      /* CoreDebug->DEMCR, TRCENA bit 24 */
+#define DWT_CTRL        0xE0001000      /* DWT->CTRL, CYCCNTENA bit 0      */
+#define DWT_CYCCNT      0xE0001004      /* DWT->CYCCNT                     */
+
+/* Word by word in C, the compiler picks the load and store instructions.   */
+static inline void copy_words(const uint32_t *src, uint32_t *dst,
+                              uint32_t words)
+{
+    while (words--)
+        *dst++ = *src++;
+}
+
+static inline void zero_words(uint32_t *dst, uint32_t words)
+{
+    while (words--)
+        *dst++ = 0;
+}
+
 __attribute__((interrupt,section(".text:Reset_Handler")))
 void Reset_Handler(void)
 {
-	/* Copy the data segment initializers from flash to SRAM. */
-	    uint32_t *pui32Src, *pui32Dest;
-
-	    pui32Src = &__data_load__;
-	    for(pui32Dest = &__data_start__; pui32Dest < &__data_end__; )
-	    {
-	        *pui32Dest++ = *pui32Src++;
-	    }
-
-	    /* Zero fill the bss segment. */
-	    __asm("    ldr     r0, =__bss_start__\n"
-	          "    ldr     r1, =__bss_end__\n"
-	          "    mov     r2, #0\n"
-	          "    .thumb_func\n"
-	          "zero_loop:\n"
-	          "    cmp     r0, r1\n"
-	          "    it      lt\n"
-	          "    strlt   r2, [r0], #4\n"
-	          "    blt     zero_loop");
-
-	    /* Call system initialization routine */
-		SystemInit();
-
-	    /* Call the application's entry point. */
-	    main();
+    const struct copy_table *copy;
+    const struct zero_table *zero;
+    uint32_t init;
+
+    /* Count the cycles from here to main(). */
+    HWREG(DEMCR) |= 0x01000000;
+    HWREG(DWT_CYCCNT) = 0;
+    HWREG(DWT_CTRL) |= 0x00000001;
+
+    /* Copy .data and the RAMFUNC code from flash to SRAM. */
+    for (copy = __copy_table_start__; copy < __copy_table_end__; copy++)
+        copy_words(copy->src, copy->dst, copy->words);
+
+    /* The RAMFUNC code is fetched on the other bus, finish the stores. */
+    __asm("    dsb\n"
+          "    isb");
+
+    /* Zero fill .bss, .noinit keeps its contents. */
+    for (zero = __zero_table_start__; zero < __zero_table_end__; zero++)
+        zero_words(zero->dst, zero->words);
+    init = HWREG(DWT_CYCCNT);
+
+    /* Call system initialization routine */
+    SystemInit();
+
+    timing_boot_init = init;
+    timing_boot_main = HWREG(DWT_CYCCNT);
+
+    /* Call the application's entry point. */
+    main();
 }
 
-/* This is the code that gets called when the processor receives a NMI.  This  */
-/* simply enters an infinite loop, preserving the system state for examination */
-/* by a debugger.                                                              */
-__attribute__((interrupt,section(".text:NMI_Handler")))
+/* Faults, the NMI and unexpected interrupts save their crash context to     */
+/* .noinit and reset, see fault.h. fault_entry() takes the stack pointer     */
+/* from LR, so the handlers must not push anything before branching to it.  */
+extern void fault_entry(void);
+
+__attribute__((naked,section(".text:NMI_Handler")))
 void NMI_Handler(void)
 {
-    /* Enter an infinite loop. */
-    while(1)
-    {
-    }
+    __asm volatile("    b       fault_entry");
 }
 
-
-/* This is the code that gets called when the processor receives a fault        */
-/* interrupt.  This simply enters an infinite loop, preserving the system state */
-/* for examination by a debugger.                                               */
-__attribute__((interrupt,section(".text:HardFault_Handler")))
+__attribute__((naked,section(".text:HardFault_Handler")))
 void HardFault_Handler(void)
 {
-    /* Enter an infinite loop. */
-    while(1)
-    {
-    }
+    __asm volatile("    b       fault_entry");
 }
 
-__attribute__((interrupt,section(".text:Default_Handler")))
+__attribute__((naked,section(".text:Default_Handler")))
 void Default_Handler(void)
 {
-	/* Enter an infinite loop. */
-	while(1)
-	{
-	}
+    __asm volatile("    b       fault_entry");
 }
 
 __attribute__((weak,alias("Default_Handler")))
@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file log.c
+ * @brief Leveled logging on top of PRINTF()
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include "log.h"
+#include "timing.h"
+
+volatile uint8_t log_level = LOG_LEVEL_TRACE;
+
+uint8_t log_set_level(uint8_t level) {
+	uint8_t prev = log_level;
+
+	log_level = level;
+
+	return prev;
+}
+
+__attribute__((weak))
+uint32_t log_clock_ms(void) {
+
+	return (uint32_t)(timing_to_ns(timing_now()) / 1000000);
+}
+
+/* Call sites with dropped messages that are not reported yet */
+static struct log_limit *log_limit_pending;
+
+static void log_limit_report(uint32_t now, uint8_t all) {
+	struct log_limit **p = &log_limit_pending, *lim;
+
+	while ((lim = *p) != NULL) {
+		if (!all && now - lim->begin < lim->interval_ms) {
+			p = &lim->next;
+			continue;
+		}
+		*p = lim->next;
+		lim->next = NULL;
+		lim->queued = 0;
+		if (lim->severity <= log_level)
+			PRINTF("%s:%d: %lu messages suppressed\n", lim->file,
+				lim->line, (unsigned long)lim->suppressed);
+		/* the next message starts a new interval */
+		lim->suppressed = 0;
+		lim->printed = 0;
+	}
+}
+
+void log_limit_flush(uint8_t all) {
+
+	if (log_limit_pending != NULL)
+		log_limit_report(log_clock_ms(), all);
+}
+
+int log_limit_check(struct log_limit *lim, uint32_t interval_ms,
+	uint32_t burst, uint32_t *suppressed) {
+	uint32_t now = log_clock_ms();
+
+	if (log_limit_pending != NULL)
+		log_limit_report(now, 0);
+
+	*suppressed = 0;
+	if (lim->printed == 0 || now - lim->begin >= interval_ms) {
+		*suppressed = lim->suppressed;
+		lim->begin = now;
+		lim->printed = 0;
+		lim->suppressed = 0;
+	}
+
+	if (lim->printed < burst) {
+		lim->printed++;
+		return 1;
+	}
+	lim->suppressed++;
+	lim->interval_ms = interval_ms;
+	if (lim->file != NULL && !lim->queued) {
+		lim->queued = 1;
+		lim->next = log_limit_pending;
+		log_limit_pending = lim;
+	}
+
+	return 0;
+}
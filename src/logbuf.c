@@ -0,0 +1,376 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file logbuf.c
+ * @brief Binary deferred logging
+ *
+ * Producers claim a position with one atomic increment of the head and
+ * fill the record at that position. Every record slot works as a seqlock:
+ * seq is 0 while the record is written and the stream position + 1 once it
+ * is complete, so the reader can tell empty, complete, torn and overwritten
+ * records apart without ever blocking a producer.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#if defined (HOST)
+#include <stdlib.h>
+#endif
+#include "logbuf.h"
+
+#if (LOGBUF_RECORDS & (LOGBUF_RECORDS - 1))
+#error "LOGBUF_RECORDS must be a power of two"
+#endif
+
+/* ThreadSanitizer does not model fences, under it the field accesses
+ * themselves carry the ordering of the fences
+ */
+#if defined (__SANITIZE_THREAD__)
+#define LOGBUF_FENCE(order)
+#define LOGBUF_STORE (__ATOMIC_RELEASE)
+#define LOGBUF_LOAD (__ATOMIC_ACQUIRE)
+#else
+#define LOGBUF_FENCE(order) __atomic_thread_fence(order)
+#define LOGBUF_STORE (__ATOMIC_RELAXED)
+#define LOGBUF_LOAD (__ATOMIC_RELAXED)
+#endif
+
+static struct logbuf_record logbuf_ring[LOGBUF_RECORDS];
+static uint32_t logbuf_head;
+static uint32_t logbuf_tail;
+static uint32_t logbuf_lost;
+
+void logbuf_put(const char *fmt, const uint32_t *words, uint32_t nwords) {
+	uint32_t pos = __atomic_fetch_add(&logbuf_head, 1, __ATOMIC_RELAXED);
+	struct logbuf_record *rec = &logbuf_ring[pos & (LOGBUF_RECORDS - 1)];
+	uint32_t i;
+
+	__atomic_store_n(&rec->seq, 0, __ATOMIC_RELAXED);
+	LOGBUF_FENCE(__ATOMIC_RELEASE);
+
+	__atomic_store_n(&rec->fmt, fmt, LOGBUF_STORE);
+	__atomic_store_n(&rec->nwords, nwords, LOGBUF_STORE);
+	if (nwords > LOGBUF_MAX_WORDS)
+		nwords = LOGBUF_MAX_WORDS;
+	for (i = 0; i < nwords; i++)
+		__atomic_store_n(&rec->words[i], words[i], LOGBUF_STORE);
+
+	__atomic_store_n(&rec->seq, pos + 1, __ATOMIC_RELEASE);
+}
+
+int logbuf_read(struct logbuf_record *rec) {
+	struct logbuf_record *slot;
+	uint32_t seq, i, nwords;
+
+	for (;;) {
+		slot = &logbuf_ring[logbuf_tail & (LOGBUF_RECORDS - 1)];
+		seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+
+		/* not written yet, or still being written */
+		if (seq == 0 || (int32_t)(seq - (logbuf_tail + 1)) < 0)
+			return 0;
+
+		/* the producers have lapped the reader */
+		if (seq != logbuf_tail + 1) {
+			logbuf_lost += seq - (logbuf_tail + 1);
+			logbuf_tail = seq - 1;
+		}
+
+		rec->seq = seq;
+		rec->fmt = __atomic_load_n(&slot->fmt, LOGBUF_LOAD);
+		rec->nwords = __atomic_load_n(&slot->nwords, LOGBUF_LOAD);
+		nwords = rec->nwords > LOGBUF_MAX_WORDS ?
+			LOGBUF_MAX_WORDS : rec->nwords;
+		for (i = 0; i < nwords; i++)
+			rec->words[i] = __atomic_load_n(&slot->words[i],
+				LOGBUF_LOAD);
+
+		LOGBUF_FENCE(__ATOMIC_ACQUIRE);
+		logbuf_tail++;
+		if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq)
+			return 1;
+
+		/* overwritten while it was copied */
+		logbuf_lost++;
+	}
+}
+
+uint32_t logbuf_dropped(void) {
+
+	return logbuf_lost;
+}
+
+__attribute__((weak))
+void logbuf_sink(const void *data, size_t len) {
+
+	(void)data;
+	(void)len;
+}
+
+/* Header of a binary record as it goes to logbuf_sink() */
+static size_t logbuf_header(const struct logbuf_record *rec, uint8_t *out) {
+	const uint8_t *src;
+	size_t i, len = 0;
+
+	src = (const uint8_t *)&rec->seq;
+	for (i = 0; i < sizeof(rec->seq); i++)
+		out[len++] = src[i];
+	src = (const uint8_t *)&rec->nwords;
+	for (i = 0; i < sizeof(rec->nwords); i++)
+		out[len++] = src[i];
+	src = (const uint8_t *)&rec->fmt;
+	for (i = 0; i < sizeof(rec->fmt); i++)
+		out[len++] = src[i];
+
+	return len;
+}
+
+/* Relocation marker that starts every binary flush */
+static size_t logbuf_marker(uint8_t *out) {
+	struct logbuf_record rec;
+
+	rec.seq = 0;
+	rec.nwords = 0;
+	rec.fmt = (const char *)(uintptr_t)&logbuf_put;
+
+	return logbuf_header(&rec, out);
+}
+
+/* Next argument word of a record, 0 once the record runs out of words */
+static uint32_t logbuf_word(const struct logbuf_record *rec, uint32_t *idx) {
+	uint32_t nwords = rec->nwords > LOGBUF_MAX_WORDS ?
+		LOGBUF_MAX_WORDS : rec->nwords;
+
+	return *idx < nwords ? rec->words[(*idx)++] : 0;
+}
+
+static uint64_t logbuf_words(const struct logbuf_record *rec, uint32_t *idx,
+	unsigned n) {
+	uint64_t value = logbuf_word(rec, idx);
+
+	if (n > 1)
+		value |= (uint64_t)logbuf_word(rec, idx) << 32;
+
+	return value;
+}
+
+size_t logbuf_format(char *out, size_t size, const char *fmt,
+	const struct logbuf_record *rec, unsigned ptr_size,
+	const char *(*string)(uint64_t addr)) {
+	char spec[32];
+	const char *str;
+	size_t len = 0, n;
+	uint32_t idx = 0;
+	unsigned words;
+	uint64_t value;
+	int wrote;
+	union {
+		double d;
+		uint64_t u;
+	} real;
+
+	if (size == 0)
+		return 0;
+	out[0] = '\0';
+
+	while (*fmt != '\0' && len + 1 < size) {
+		if (*fmt != '%' || fmt[1] == '%') {
+			out[len++] = *fmt;
+			fmt += *fmt == '%' ? 2 : 1;
+			continue;
+		}
+
+		/* flags, width and precision, '*' resolved to the stored int */
+		n = 0;
+		spec[n++] = *fmt++;
+		while (*fmt != '\0' && n < sizeof(spec) - 16) {
+			if (*fmt == '*') {
+				n += snprintf(spec + n, sizeof(spec) - n, "%ld",
+					(long)(int32_t)logbuf_word(rec, &idx));
+				fmt++;
+			} else if ((*fmt >= '0' && *fmt <= '9') || *fmt == '-' ||
+				*fmt == '+' || *fmt == ' ' || *fmt == '#' ||
+				*fmt == '.') {
+				spec[n++] = *fmt++;
+			} else {
+				break;
+			}
+		}
+
+		/* length modifiers only decide how many words an argument has */
+		words = 1;
+		while (*fmt == 'h' || *fmt == 'l' || *fmt == 'j' || *fmt == 'z' ||
+			*fmt == 't' || *fmt == 'L' || *fmt == 'q') {
+			if (*fmt == 'l' && fmt[1] == 'l')
+				words = 2, fmt++;
+			else if (*fmt == 'j' || *fmt == 'q')
+				words = 2;
+			else if (*fmt == 'l' || *fmt == 'z' || *fmt == 't')
+				words = ptr_size / 4;
+			fmt++;
+		}
+		if (*fmt == '\0')
+			break;
+
+		switch (*fmt) {
+		case 'd':
+		case 'i':
+			value = logbuf_words(rec, &idx, words);
+			snprintf(spec + n, sizeof(spec) - n, "ll%c", *fmt);
+			wrote = snprintf(out + len, size - len, spec, words > 1 ?
+				(long long)(int64_t)value :
+				(long long)(int32_t)value);
+			break;
+		case 'u':
+		case 'o':
+		case 'x':
+		case 'X':
+			value = logbuf_words(rec, &idx, words);
+			snprintf(spec + n, sizeof(spec) - n, "ll%c", *fmt);
+			wrote = snprintf(out + len, size - len, spec,
+				(unsigned long long)value);
+			break;
+		case 'c':
+			spec[n++] = 'c';
+			spec[n] = '\0';
+			wrote = snprintf(out + len, size - len, spec,
+				(int)logbuf_word(rec, &idx));
+			break;
+		case 'e':
+		case 'E':
+		case 'f':
+		case 'F':
+		case 'g':
+		case 'G':
+		case 'a':
+		case 'A':
+			real.u = logbuf_words(rec, &idx, 2);
+			spec[n++] = *fmt;
+			spec[n] = '\0';
+			wrote = snprintf(out + len, size - len, spec, real.d);
+			break;
+		case 's':
+			value = logbuf_words(rec, &idx, ptr_size / 4);
+			str = string != NULL ? string(value) : NULL;
+			spec[n++] = 's';
+			spec[n] = '\0';
+			wrote = snprintf(out + len, size - len, spec,
+				str != NULL ? str : "(unknown)");
+			break;
+		case 'p':
+			value = logbuf_words(rec, &idx, ptr_size / 4);
+			wrote = snprintf(out + len, size - len, "0x%llx",
+				(unsigned long long)value);
+			break;
+		default:
+			/* %n and unknown conversions are not replayed */
+			wrote = 0;
+			break;
+		}
+		fmt++;
+
+		if (wrote > 0)
+			len += (size_t)wrote;
+		if (len >= size)
+			len = size - 1;
+	}
+	out[len] = '\0';
+
+	return len;
+}
+
+#if defined (HOST)
+
+static const char *logbuf_string(uint64_t addr) {
+
+	return (const char *)(uintptr_t)addr;
+}
+
+static FILE *logbuf_out;
+static uint8_t logbuf_out_ready;
+
+/* LOGBUF_FILE is opened and truncated by the first flush only, the later
+ * ones append to it
+ */
+static FILE *logbuf_file(void) {
+	const char *name;
+
+	if (!logbuf_out_ready) {
+		logbuf_out_ready = 1;
+		name = getenv("LOGBUF_FILE");
+		if (name != NULL && (logbuf_out = fopen(name, "wb")) == NULL)
+			perror(name);
+	}
+
+	return logbuf_out;
+}
+
+FILE *logbuf_set_file(FILE *file) {
+	FILE *prev;
+
+	logbuf_flush();
+	prev = logbuf_file();
+	logbuf_out = file;
+
+	return prev;
+}
+
+void logbuf_flush(void) {
+	struct logbuf_record rec;
+	uint8_t header[2 * sizeof(uint32_t) + sizeof(const char *)];
+	char text[512];
+	uint32_t nwords;
+	FILE *out = logbuf_file();
+
+	if (out != NULL)
+		fwrite(header, 1, logbuf_marker(header), out);
+
+	while (logbuf_read(&rec)) {
+		if (out == NULL) {
+			logbuf_format(text, sizeof(text), rec.fmt, &rec,
+				sizeof(void *), logbuf_string);
+			fputs(text, stdout);
+			continue;
+		}
+		nwords = rec.nwords > LOGBUF_MAX_WORDS ?
+			LOGBUF_MAX_WORDS : rec.nwords;
+		rec.nwords = nwords;
+		fwrite(header, 1, logbuf_header(&rec, header), out);
+		fwrite(rec.words, sizeof(uint32_t), nwords, out);
+	}
+
+	if (logbuf_lost)
+		fprintf(stderr, "logbuf: %u records lost\n", logbuf_lost);
+	if (out != NULL)
+		fflush(out);
+	fflush(stdout);
+}
+
+#else
+
+void logbuf_flush(void) {
+	struct logbuf_record rec;
+	uint8_t header[2 * sizeof(uint32_t) + sizeof(const char *)];
+
+	logbuf_sink(header, logbuf_marker(header));
+	while (logbuf_read(&rec)) {
+		if (rec.nwords > LOGBUF_MAX_WORDS)
+			rec.nwords = LOGBUF_MAX_WORDS;
+		logbuf_sink(header, logbuf_header(&rec, header));
+		logbuf_sink(rec.words, rec.nwords * sizeof(uint32_t));
+	}
+}
+
+#endif
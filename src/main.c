@@ -22,13 +22,33 @@
  */
 
 #include "course1.h"
+#include "bench.h"
+#include "fault.h"
+#include "perf.h"
+#include "platform.h"
 
 /* A pretty boring main file */
 int main(void) {
+	int ret = 0;
+
+	/* crash context of the last boot, if it ended in a fault */
+	fault_report();
 
 #ifdef COURSE1
-	course1();
+	/* failed tests fail the run, so that memcheck can catch them */
+	ret = course1() ? 1 : 0;
+#endif
+
+#ifdef BENCH
+	bench();
 #endif
 
-	return 0;
+#ifdef PERF
+	if (perf())
+		ret = 1;
+#endif
+
+	PRINTF_FLUSH();
+
+	return ret;
 }
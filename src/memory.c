@@ -20,39 +20,41 @@
  * @date April 1 2017
  *
  */
+#define LOG_MODULE_LEVEL MEMORY_LOG_LEVEL
+
 #include <stdint.h>
 #include <stdlib.h>
 #include "memory.h"
-#include "platform.h"
+#include "log.h"
 
 
 /***********************************************************
  Function Definitions
 ***********************************************************/
-void set_value(uint8_t *ptr, uint8_t index, uint8_t value) {
+void set_value(uint8_t *ptr, size_t index, uint8_t value) {
 
 	ptr[index] = value;
 }
 
-void clear_value(uint8_t *ptr, uint8_t index) {
+void clear_value(uint8_t *ptr, size_t index) {
 
 	set_value(ptr, index, 0);
 }
 
-uint8_t get_value(uint8_t *ptr, uint8_t index) {
+uint8_t get_value(uint8_t *ptr, size_t index) {
 
 	return ptr[index];
 }
 
-void set_all(uint8_t *ptr, uint8_t value, uint8_t size) {
-	uint8_t i;
+void set_all(uint8_t *ptr, uint8_t value, size_t size) {
+	size_t i;
 
 	for(i = 0; i < size; i++) {
 		set_value(ptr, i, value);
 	}
 }
 
-void clear_all(uint8_t *ptr, uint8_t size) {
+void clear_all(uint8_t *ptr, size_t size) {
 
 	set_all(ptr, 0, size);
 }
@@ -60,7 +62,7 @@ void clear_all(uint8_t *ptr, uint8_t size) {
 uint8_t *my_memmove(uint8_t *src, uint8_t *dst, size_t length) {
 
 	if(src == dst) {
-		PRINTF("WARN: src and dst are the same !\n");
+		LOG_RATELIMITED(WARN, "WARN: src and dst are the same !\n");
 
 		return dst;
 
@@ -84,7 +86,7 @@ uint8_t *my_memmove(uint8_t *src, uint8_t *dst, size_t length) {
 	return dst;
 }
 
-uint8_t *my_memcopy(uint8_t *src, uint8_t *dst, size_t length) {
+RAMFUNC uint8_t *my_memcopy(uint8_t *src, uint8_t *dst, size_t length) {
 	const uint8_t *source = (const uint8_t *)src;
 	uint8_t *p = dst;
 
@@ -97,7 +99,7 @@ uint8_t *my_memcopy(uint8_t *src, uint8_t *dst, size_t length) {
 	return dst;
 }
 
-uint8_t * my_memset(uint8_t *src, size_t length, uint8_t value) {
+RAMFUNC uint8_t * my_memset(uint8_t *src, size_t length, uint8_t value) {
 	while(length--) {
 		*src = value;
 		src++;
@@ -116,7 +118,7 @@ uint8_t *my_reverse(uint8_t *src, size_t length) {
 	uint8_t tmp;
 	uint8_t *source = src;
 
-	for (uint8_t i=0; i < lim; i++) {
+	for (size_t i=0; i < lim; i++) {
 		length--;
 		tmp = *source;
 		*source = *(src+length*sizeof(uint8_t));
@@ -131,7 +133,7 @@ int32_t *reserve_words(size_t length) {
 	int32_t *src = calloc(length, sizeof(int32_t));
 
 	if (src == NULL) {
-		PRINTF("FATAL: Memory not allocated.\n");
+		LOG_ERROR("FATAL: Memory not allocated.\n");
 		return NULL;
 	}
 
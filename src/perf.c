@@ -0,0 +1,444 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file perf.c
+ * @brief Performance regression check of the memory, data and stats kernels
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "data.h"
+#include "memory.h"
+#include "perf.h"
+#include "platform.h"
+#include "stats.h"
+#include "timing.h"
+
+/* Bytes or elements a kernel works on, below the parallel sort size */
+#define PERF_SIZE (4096)
+/* Numbers converted per call of the data kernels */
+#define PERF_NUMBERS (16)
+/* Upper bound of the calls per trial */
+#define PERF_MAX_CALLS (1UL << 24)
+
+struct perf_kernel {
+	const char *name;
+	void (*run)(void);
+};
+
+static uint8_t perf_buf[2 * PERF_SIZE];
+static uint8_t perf_bytes[PERF_SIZE];
+static uint8_t perf_bytes_work[PERF_SIZE];
+static int32_t perf_set[PERF_SIZE];
+static int32_t perf_work[PERF_SIZE];
+static int32_t perf_numbers[PERF_NUMBERS];
+static uint8_t perf_dec[PERF_NUMBERS][MAX_LEN];
+static uint8_t perf_dec_len[PERF_NUMBERS];
+static uint8_t perf_hex[PERF_NUMBERS][MAX_LEN];
+static uint8_t perf_hex_len[PERF_NUMBERS];
+/* Results go here, so that no call can be optimized away */
+static volatile uint32_t perf_sink;
+
+/* xorshift32, the same data sets and resamples on every run */
+static uint32_t perf_random(uint32_t *state) {
+	uint32_t x = *state;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+
+	return *state = x;
+}
+
+static void perf_memmove(void) {
+
+	/* overlapping, the backward copy */
+	my_memmove(perf_buf, perf_buf + 1, PERF_SIZE);
+	perf_sink += perf_buf[PERF_SIZE];
+}
+
+static void perf_memcopy(void) {
+
+	my_memcopy(perf_buf, perf_buf + PERF_SIZE, PERF_SIZE);
+	perf_sink += perf_buf[PERF_SIZE];
+}
+
+static void perf_memset(void) {
+
+	my_memset(perf_buf, PERF_SIZE, 0xA5);
+	perf_sink += perf_buf[PERF_SIZE - 1];
+}
+
+static void perf_memzero(void) {
+
+	my_memzero(perf_buf, PERF_SIZE);
+	perf_sink += perf_buf[PERF_SIZE - 1];
+}
+
+static void perf_reverse(void) {
+
+	my_reverse(perf_buf, PERF_SIZE);
+	perf_sink += perf_buf[0];
+}
+
+static void perf_itoa_10(void) {
+	uint8_t str[MAX_LEN];
+	uint8_t i;
+
+	for (i = 0; i < PERF_NUMBERS; i++)
+		perf_sink += my_itoa(perf_numbers[i], str, BASE_10);
+}
+
+static void perf_itoa_16(void) {
+	uint8_t str[MAX_LEN];
+	uint8_t i;
+
+	for (i = 0; i < PERF_NUMBERS; i++)
+		perf_sink += my_itoa(perf_numbers[i], str, BASE_16);
+}
+
+static void perf_atoi_10(void) {
+	uint8_t str[MAX_LEN];
+	uint8_t i;
+
+	/* my_atoi() reverses decimal strings in place, start from a copy */
+	for (i = 0; i < PERF_NUMBERS; i++) {
+		memcpy(str, perf_dec[i], perf_dec_len[i]);
+		perf_sink += my_atoi(str, perf_dec_len[i], BASE_10);
+	}
+}
+
+static void perf_atoi_16(void) {
+	uint8_t i;
+
+	for (i = 0; i < PERF_NUMBERS; i++)
+		perf_sink += my_atoi(perf_hex[i], perf_hex_len[i], BASE_16);
+}
+
+static void perf_sort_u8(void) {
+
+	memcpy(perf_bytes_work, perf_bytes, sizeof(perf_bytes));
+	sort_array(perf_bytes_work, PERF_SIZE);
+	perf_sink += perf_bytes_work[0];
+}
+
+static void perf_sort_i32(void) {
+
+	memcpy(perf_work, perf_set, sizeof(perf_set));
+	sort_array_i32(perf_work, PERF_SIZE);
+	perf_sink += perf_work[0];
+}
+
+static void perf_median_i32(void) {
+
+	memcpy(perf_work, perf_set, sizeof(perf_set));
+	perf_sink += find_median_i32(perf_work, PERF_SIZE);
+}
+
+static void perf_mean_i32(void) {
+
+	perf_sink += find_mean_i32(perf_set, PERF_SIZE);
+}
+
+static const struct perf_kernel perf_kernels[] = {
+	{ "my_memmove", perf_memmove },
+	{ "my_memcopy", perf_memcopy },
+	{ "my_memset", perf_memset },
+	{ "my_memzero", perf_memzero },
+	{ "my_reverse", perf_reverse },
+	{ "my_itoa_10", perf_itoa_10 },
+	{ "my_itoa_16", perf_itoa_16 },
+	{ "my_atoi_10", perf_atoi_10 },
+	{ "my_atoi_16", perf_atoi_16 },
+	{ "sort_array_u8", perf_sort_u8 },
+	{ "sort_array_i32", perf_sort_i32 },
+	{ "find_median_i32", perf_median_i32 },
+	{ "find_mean_i32", perf_mean_i32 },
+};
+
+#define PERF_KERNELS (sizeof(perf_kernels) / sizeof(perf_kernels[0]))
+
+static double perf_samples[PERF_KERNELS][PERF_MAX_TRIALS];
+static uint32_t perf_calls[PERF_KERNELS];
+
+static void perf_setup(void) {
+	uint32_t seed = 2463534242UL;
+	size_t i;
+
+	for (i = 0; i < sizeof(perf_buf); i++)
+		perf_buf[i] = (uint8_t)perf_random(&seed);
+	for (i = 0; i < PERF_SIZE; i++) {
+		perf_bytes[i] = (uint8_t)perf_random(&seed);
+		perf_set[i] = (int32_t)perf_random(&seed);
+	}
+	/* every number of digits, both signs */
+	for (i = 0; i < PERF_NUMBERS; i++) {
+		perf_numbers[i] = (int32_t)(perf_random(&seed) >> (2 * i + 1));
+		if (i & 1)
+			perf_numbers[i] = -perf_numbers[i];
+		perf_dec_len[i] = my_itoa(perf_numbers[i], perf_dec[i], BASE_10);
+		perf_hex_len[i] = my_itoa(perf_numbers[i], perf_hex[i], BASE_16);
+	}
+}
+
+static uint64_t perf_time(void (*run)(void), uint32_t calls) {
+	uint64_t start = timing_now();
+
+	while (calls--)
+		run();
+
+	return timing_to_ns(timing_now() - start);
+}
+
+/* Calls per trial, doubled until a trial takes PERF_TRIAL_NS */
+static uint32_t perf_calibrate(void (*run)(void)) {
+	uint32_t calls = 1;
+
+	while (calls < PERF_MAX_CALLS && perf_time(run, calls) < PERF_TRIAL_NS)
+		calls *= 2;
+
+	return calls;
+}
+
+static int perf_cmp(const void *a, const void *b) {
+	double x = *(const double *)a;
+	double y = *(const double *)b;
+
+	return (x > y) - (x < y);
+}
+
+/* Sorts the samples in place */
+static double perf_median(double *x, unsigned n) {
+
+	qsort(x, n, sizeof(double), perf_cmp);
+
+	return n & 1 ? x[n / 2] : (x[n / 2 - 1] + x[n / 2]) / 2;
+}
+
+#if defined (HOST)
+#include <ctype.h>
+#include <stdio.h>
+
+static unsigned perf_env(const char *name, unsigned def) {
+	const char *env = getenv(name);
+	long n;
+
+	if (env != NULL && (n = strtol(env, NULL, 10)) > 0)
+		return (unsigned)n;
+
+	return def;
+}
+
+/* Whole file as a string, NULL if it can not be read */
+static char *perf_load(const char *name) {
+	FILE *in = fopen(name, "rb");
+	char *json = NULL;
+	long len;
+
+	if (in == NULL)
+		return NULL;
+	if (fseek(in, 0, SEEK_END) == 0 && (len = ftell(in)) >= 0 &&
+		fseek(in, 0, SEEK_SET) == 0 && (json = malloc(len + 1)) != NULL) {
+		if (fread(json, 1, len, in) == (size_t)len) {
+			json[len] = '\0';
+		} else {
+			free(json);
+			json = NULL;
+		}
+	}
+	fclose(in);
+
+	return json;
+}
+
+/* Samples of a kernel from a baseline written by perf_save() */
+static unsigned perf_baseline(const char *json, const char *name,
+	double *out) {
+	char key[64];
+	const char *p;
+	char *end;
+	unsigned n = 0;
+
+	snprintf(key, sizeof(key), "\"%s\"", name);
+	if ((p = strstr(json, key)) == NULL ||
+		(p = strstr(p, "\"samples\"")) == NULL ||
+		(p = strchr(p, '[')) == NULL)
+		return 0;
+
+	for (p++; n < PERF_MAX_TRIALS; p = end) {
+		out[n] = strtod(p, &end);
+		if (end == p)
+			break;
+		n++;
+		while (*end == ',' || isspace((unsigned char)*end))
+			end++;
+	}
+
+	return n;
+}
+
+static FILE *perf_save_open(const char *name, unsigned trials) {
+	FILE *out = fopen(name, "w");
+
+	if (out == NULL) {
+		perror(name);
+		return NULL;
+	}
+	fprintf(out, "{\n\t\"unit\": \"ns\",\n\t\"trials\": %u,\n"
+		"\t\"kernels\": {\n", trials);
+
+	return out;
+}
+
+static void perf_save(FILE *out, const char *name, const double *samples,
+	unsigned n, double median, int last) {
+	unsigned i;
+
+	fprintf(out, "\t\t\"%s\": {\n\t\t\t\"median\": %.3f,\n"
+		"\t\t\t\"samples\": [", name, median);
+	for (i = 0; i < n; i++)
+		fprintf(out, "%s%.3f", i ? ", " : "", samples[i]);
+	fprintf(out, "]\n\t\t}%s\n", last ? "" : ",");
+}
+
+/*
+ * Bootstrap confidence interval of the ratio of the medians: both sample
+ * sets are resampled with replacement and the ratio of their medians is
+ * taken PERF_RESAMPLES times.
+ */
+static void perf_interval(const double *base, unsigned nbase,
+	const double *now, unsigned nnow, double *lo, double *hi) {
+	static double ratios[PERF_RESAMPLES];
+	double a[PERF_MAX_TRIALS], b[PERF_MAX_TRIALS];
+	uint32_t seed = 2463534242UL;
+	unsigned r, i, tail;
+
+	for (r = 0; r < PERF_RESAMPLES; r++) {
+		for (i = 0; i < nbase; i++)
+			a[i] = base[perf_random(&seed) % nbase];
+		for (i = 0; i < nnow; i++)
+			b[i] = now[perf_random(&seed) % nnow];
+		ratios[r] = perf_median(b, nnow) / perf_median(a, nbase);
+	}
+	qsort(ratios, PERF_RESAMPLES, sizeof(double), perf_cmp);
+
+	tail = PERF_RESAMPLES * (100 - PERF_CONFIDENCE) / 200;
+	*lo = ratios[tail];
+	*hi = ratios[PERF_RESAMPLES - 1 - tail];
+}
+#endif
+
+uint8_t perf(void) {
+	double sorted[PERF_MAX_TRIALS];
+	unsigned trials = PERF_TRIALS;
+	uint8_t regressions = 0;
+	double median;
+	unsigned k, t;
+#if defined (HOST)
+	unsigned threshold = perf_env("PERF_THRESHOLD", PERF_THRESHOLD);
+	const char *baseline_name = getenv("PERF_BASELINE");
+	const char *save_name = getenv("PERF_SAVE");
+	char *baseline = NULL;
+	double base[PERF_MAX_TRIALS];
+	double base_median, lo, hi;
+	const char *verdict;
+	unsigned nbase;
+	FILE *save = NULL;
+
+	trials = perf_env("PERF_TRIALS", PERF_TRIALS);
+	if (trials > PERF_MAX_TRIALS)
+		trials = PERF_MAX_TRIALS;
+	if (baseline_name != NULL && *baseline_name != '\0' &&
+		(baseline = perf_load(baseline_name)) == NULL)
+		PRINTF("perf(): no baseline in %s\n", baseline_name);
+	if (save_name != NULL && *save_name != '\0')
+		save = perf_save_open(save_name, trials);
+#endif
+
+	perf_setup();
+
+	PRINTF("perf(): %u trials per kernel, cycles at %lu Hz\n", trials,
+		(unsigned long)SystemCoreClock);
+	PRINTF("  kernel            median, ns     cycles");
+#if defined (HOST)
+	if (baseline != NULL)
+		PRINTF("  baseline, ns   ratio   %u%% interval", PERF_CONFIDENCE);
+#endif
+	PRINTF("\n");
+
+	/* calibration also warms up the caches and the branch predictors */
+	for (k = 0; k < PERF_KERNELS; k++)
+		perf_calls[k] = perf_calibrate(perf_kernels[k].run);
+	/* the trials of all kernels take turns, so that slow drifts of the
+	 * machine hit every kernel alike
+	 */
+	for (t = 0; t < trials; t++)
+		for (k = 0; k < PERF_KERNELS; k++)
+			perf_samples[k][t] = (double)perf_time(perf_kernels[k].run,
+				perf_calls[k]) / perf_calls[k];
+
+	for (k = 0; k < PERF_KERNELS; k++) {
+		memcpy(sorted, perf_samples[k], trials * sizeof(double));
+		median = perf_median(sorted, trials);
+		PRINTF("  %-16s %12.1f %10.0f", perf_kernels[k].name, median,
+			median * SystemCoreClock / 1e9);
+
+#if defined (HOST)
+		if (save != NULL)
+			perf_save(save, perf_kernels[k].name, perf_samples[k],
+				trials, median, k == PERF_KERNELS - 1);
+
+		if (baseline != NULL) {
+			nbase = perf_baseline(baseline, perf_kernels[k].name, base);
+			if (nbase == 0) {
+				PRINTF("  not in baseline");
+			} else {
+				memcpy(sorted, base, nbase * sizeof(double));
+				base_median = perf_median(sorted, nbase);
+				perf_interval(base, nbase, perf_samples[k], trials,
+					&lo, &hi);
+
+				/* slower only if the whole interval says so */
+				verdict = "";
+				if (lo > 1 + threshold / 100.0) {
+					verdict = "  REGRESSION";
+					regressions++;
+				} else if (hi < 1 - threshold / 100.0) {
+					verdict = "  faster";
+				}
+				PRINTF(" %13.1f %7.3f  [%.3f, %.3f]%s", base_median,
+					median / base_median, lo, hi, verdict);
+			}
+		}
+#endif
+		PRINTF("\n");
+	}
+
+#if defined (HOST)
+	if (save != NULL) {
+		fprintf(save, "\t}\n}\n");
+		fclose(save);
+		PRINTF("perf(): samples saved to %s\n", save_name);
+	}
+	if (baseline != NULL) {
+		PRINTF("perf(): %u of %u kernels slower than the baseline by more "
+			"than %u%%\n", regressions, (unsigned)PERF_KERNELS, threshold);
+		free(baseline);
+	}
+#endif
+
+	return regressions;
+}
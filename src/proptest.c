@@ -0,0 +1,327 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file proptest.c
+ * @brief Property based tests of memory.c (HOST)
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#define LOG_MODULE_LEVEL COURSE1_LOG_LEVEL
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "log.h"
+#include "memory.h"
+#include "proptest.h"
+#include "timing.h"
+
+#define PROPTEST_MAX_SIZE (4096)
+#define PROPTEST_GUARD (16)
+#define PROPTEST_ALIGN (16)
+/* Stop reporting after this many failed cases */
+#define PROPTEST_MAX_FAILED (10)
+
+enum proptest_op {
+	PROPTEST_MEMMOVE,
+	PROPTEST_MEMCOPY,
+	PROPTEST_MEMSET,
+	PROPTEST_REVERSE,
+	PROPTEST_OPS
+};
+
+static const char *const proptest_names[PROPTEST_OPS] = {
+	"my_memmove", "my_memcopy", "my_memset", "my_reverse",
+};
+
+/* Offsets are relative to the buffer, which starts align bytes after a
+ * PROPTEST_ALIGN boundary */
+struct proptest_case {
+	uint8_t op;
+	uint8_t align;
+	uint8_t value;
+	uint32_t fill;
+	size_t size;
+	size_t src;
+	size_t dst;
+	size_t len;
+};
+
+static uint8_t proptest_mem[2][PROPTEST_ALIGN + PROPTEST_MAX_SIZE +
+	2 * PROPTEST_GUARD] __attribute__((aligned(PROPTEST_ALIGN)));
+
+/* splitmix64 */
+static uint64_t proptest_next(uint64_t *state) {
+	uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+
+	return z ^ (z >> 31);
+}
+
+static size_t proptest_below(uint64_t *state, size_t n) {
+
+	return n ? proptest_next(state) % n : 0;
+}
+
+static size_t proptest_min(size_t a, size_t b) {
+
+	return a < b ? a : b;
+}
+
+/* Two disjoint ranges of len bytes in random order */
+static void proptest_disjoint(uint64_t *st, struct proptest_case *c) {
+	size_t a, b;
+
+	c->len = proptest_below(st, c->size / 2 + 1);
+	a = proptest_below(st, c->size - 2 * c->len + 1);
+	b = a + c->len + proptest_below(st, c->size - 2 * c->len - a + 1);
+	if (proptest_next(st) & 1) {
+		c->src = a;
+		c->dst = b;
+	} else {
+		c->src = b;
+		c->dst = a;
+	}
+}
+
+static void proptest_generate(uint64_t seed, struct proptest_case *c) {
+	uint64_t st = seed;
+	size_t delta;
+
+	c->op = proptest_below(&st, PROPTEST_OPS);
+	c->align = proptest_below(&st, PROPTEST_ALIGN);
+	c->value = proptest_next(&st);
+	c->fill = proptest_next(&st);
+	/* sizes spread evenly over the powers of two up to 4096 */
+	c->size = 1 + proptest_below(&st, (size_t)1 << proptest_below(&st, 13));
+
+	switch (c->op) {
+	case PROPTEST_MEMMOVE:
+		switch (proptest_below(&st, 4)) {
+		case 0:
+			proptest_disjoint(&st, c);
+			break;
+		case 1:
+		case 2:
+			/* overlap in either direction, needs size >= 3 */
+			if (c->size < 3) {
+				proptest_disjoint(&st, c);
+				break;
+			}
+			c->len = 2 + proptest_below(&st, c->size - 2);
+			delta = 1 + proptest_below(&st,
+				proptest_min(c->len - 1, c->size - c->len));
+			c->src = proptest_below(&st, c->size - c->len - delta + 1);
+			c->dst = c->src + delta;
+			if (proptest_next(&st) & 1) {
+				c->dst = c->src;
+				c->src += delta;
+			}
+			break;
+		default:
+			c->len = proptest_below(&st, c->size + 1);
+			c->src = c->dst = proptest_below(&st, c->size - c->len + 1);
+			break;
+		}
+		break;
+	case PROPTEST_MEMCOPY:
+		proptest_disjoint(&st, c);
+		break;
+	case PROPTEST_MEMSET:
+	case PROPTEST_REVERSE:
+	default:
+		c->len = proptest_below(&st, c->size + 1);
+		c->src = c->dst = proptest_below(&st, c->size - c->len + 1);
+		break;
+	}
+}
+
+static int proptest_valid(const struct proptest_case *c) {
+
+	if (c->size < 1 || c->size > PROPTEST_MAX_SIZE ||
+		c->align >= PROPTEST_ALIGN ||
+		c->src + c->len > c->size || c->dst + c->len > c->size)
+		return 0;
+	if (c->op == PROPTEST_MEMCOPY &&
+		c->src < c->dst + c->len && c->dst < c->src + c->len)
+		return 0;
+
+	return 1;
+}
+
+/* Runs one case against the C library, returns 1 if the buffers match */
+static int proptest_check(const struct proptest_case *c) {
+	uint8_t *buf = proptest_mem[0] + PROPTEST_GUARD + c->align;
+	uint8_t *ref = proptest_mem[1] + PROPTEST_GUARD + c->align;
+	uint32_t x = c->fill | 1;
+	size_t i;
+	uint8_t tmp;
+
+	for (i = 0; i < sizeof(proptest_mem[0]); i++) {
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		proptest_mem[0][i] = proptest_mem[1][i] = (uint8_t)x;
+	}
+
+	switch (c->op) {
+	case PROPTEST_MEMMOVE:
+		my_memmove(buf + c->src, buf + c->dst, c->len);
+		memmove(ref + c->dst, ref + c->src, c->len);
+		break;
+	case PROPTEST_MEMCOPY:
+		my_memcopy(buf + c->src, buf + c->dst, c->len);
+		memcpy(ref + c->dst, ref + c->src, c->len);
+		break;
+	case PROPTEST_MEMSET:
+		my_memset(buf + c->dst, c->len, c->value);
+		memset(ref + c->dst, c->value, c->len);
+		break;
+	case PROPTEST_REVERSE:
+		my_reverse(buf + c->dst, c->len);
+		for (i = 0; i < c->len / 2; i++) {
+			tmp = ref[c->dst + i];
+			ref[c->dst + i] = ref[c->dst + c->len - i - 1];
+			ref[c->dst + c->len - i - 1] = tmp;
+		}
+		break;
+	}
+
+	/* the guard bytes on both sides have to match as well */
+	return memcmp(proptest_mem[0], proptest_mem[1],
+		sizeof(proptest_mem[0])) == 0;
+}
+
+/* One smaller variant of a case, returns 0 when there are no more */
+static int proptest_smaller(const struct proptest_case *c, unsigned step,
+	struct proptest_case *t) {
+
+	*t = *c;
+	switch (step) {
+	case 0: t->len /= 2; break;
+	case 1: t->len -= t->len > 0; break;
+	case 2: t->src /= 2; t->dst /= 2; break;
+	case 3:
+		if (t->src > 0 && t->dst > 0) {
+			t->src--;
+			t->dst--;
+		}
+		break;
+	case 4: t->src /= 2; break;
+	case 5: t->dst /= 2; break;
+	case 6: t->src -= t->src > 0; break;
+	case 7: t->dst -= t->dst > 0; break;
+	case 8:
+		t->size = (t->src > t->dst ? t->src : t->dst) + t->len;
+		break;
+	case 9: t->size -= 1; break;
+	case 10: t->align = 0; break;
+	case 11: t->align -= t->align > 0; break;
+	case 12: t->value = 0; break;
+	case 13: t->fill = 0; break;
+	default: return 0;
+	}
+
+	return 1;
+}
+
+/* Greedy shrinking: keep every smaller variant that still fails */
+static void proptest_shrink(struct proptest_case *c) {
+	struct proptest_case t;
+	unsigned step;
+	int progress = 1;
+
+	while (progress) {
+		progress = 0;
+		for (step = 0; proptest_smaller(c, step, &t); step++) {
+			if (memcmp(&t, c, sizeof(t)) == 0 || !proptest_valid(&t) ||
+				proptest_check(&t))
+				continue;
+			*c = t;
+			progress = 1;
+		}
+	}
+}
+
+static void proptest_report(const char *what, const struct proptest_case *c) {
+
+	/* two calls, DEFERRED_LOG takes at most 8 arguments per call */
+	LOG_ERROR("  %s %s: size %lu align %u src %lu dst %lu", what,
+		proptest_names[c->op], (unsigned long)c->size, c->align,
+		(unsigned long)c->src, (unsigned long)c->dst);
+	LOG_ERROR(" len %lu value %u fill 0x%lx\n", (unsigned long)c->len,
+		c->value, (unsigned long)c->fill);
+}
+
+/* Returns 1 if the case with this seed passes */
+static int proptest_case(uint64_t seed) {
+	struct proptest_case c;
+
+	proptest_generate(seed, &c);
+	if (proptest_check(&c))
+		return 1;
+
+	LOG_ERROR("proptest: FAILED, replay with PROPTEST_REPLAY=0x%llx\n",
+		(unsigned long long)seed);
+	proptest_report("failing", &c);
+	proptest_shrink(&c);
+	proptest_report("shrunk ", &c);
+
+	return 0;
+}
+
+static uint64_t proptest_env(const char *name, uint64_t def) {
+	const char *env = getenv(name);
+
+	return env != NULL && *env != '\0' ? strtoull(env, NULL, 0) : def;
+}
+
+void proptest_config(struct proptest_config *cfg) {
+
+	cfg->seed = proptest_env("PROPTEST_SEED", PROPTEST_SEED);
+	cfg->cases = proptest_env("PROPTEST_CASES", PROPTEST_CASES);
+	cfg->soak_s = proptest_env("PROPTEST_SOAK", 0);
+	cfg->replay = proptest_env("PROPTEST_REPLAY", 0);
+}
+
+uint32_t proptest_run(const struct proptest_config *cfg) {
+	uint64_t state = cfg->seed;
+	uint64_t end = timing_to_ns(timing_now()) + cfg->soak_s * 1000000000ULL;
+	uint32_t cases = 0, failed = 0;
+	uint8_t level;
+
+	/* my_memmove() warns about src == dst, which is one of the layouts */
+	level = log_set_level(LOG_LEVEL_ERROR);
+
+	if (cfg->replay) {
+		cases = 1;
+		failed = !proptest_case(cfg->replay);
+	} else {
+		while (failed < PROPTEST_MAX_FAILED && (cfg->soak_s ?
+			timing_to_ns(timing_now()) < end : cases < cfg->cases)) {
+			failed += !proptest_case(proptest_next(&state));
+			cases++;
+		}
+	}
+
+	log_set_level(level);
+	if (cfg->soak_s || cfg->replay || failed)
+		LOG_INFO("proptest: %lu cases, %lu failed, seed 0x%llx\n",
+			(unsigned long)cases, (unsigned long)failed,
+			(unsigned long long)cfg->seed);
+
+	return failed;
+}
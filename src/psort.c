@@ -0,0 +1,288 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file: psort.c
+ * @brief: Parallel radix sort of large host-side arrays.
+ *
+ * Every thread owns one contiguous slice of the input. A pass takes three
+ * phases separated by barriers: count the digits of the own slice, turn
+ * the per-thread histograms into scatter offsets (thread 0 only), scatter
+ * the own slice. Thread t writes bucket b right after the part of bucket b
+ * written by threads 0..t-1, which keeps every pass stable. Keys are
+ * mapped so that ascending unsigned key order is descending value order.
+ *
+ * @author: Valentina Krasnobaeva
+ * @date: 10/18/2026
+ *
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include "platform.h"
+#include "pstats.h"
+#include "psort.h"
+
+#define PSORT_RADIX (UINT8_MAX + 1)
+
+/* Write-combining buffers flush one cache line at a time */
+#define PSORT_LINE (64)
+
+struct psort_ctx {
+	void *array;
+	void *scratch;
+	size_t size;
+	unsigned threads;
+	size_t (*hist)[PSORT_RADIX];
+	size_t start[PSORT_RADIX + 1];
+	int skip;
+	int started;
+	pthread_mutex_t lock;
+	pthread_cond_t go;
+	pthread_barrier_t barrier;
+};
+
+struct psort_worker {
+	struct psort_ctx *ctx;
+	unsigned id;
+	uint8_t *line;
+	pthread_t thread;
+};
+
+/* Workers wait here until the number of threads which really started is known */
+static struct psort_ctx *psort_start(struct psort_worker *w, size_t *begin,
+	size_t *end) {
+	struct psort_ctx *ctx = w->ctx;
+
+	pthread_mutex_lock(&ctx->lock);
+	while (!ctx->started)
+		pthread_cond_wait(&ctx->go, &ctx->lock);
+	pthread_mutex_unlock(&ctx->lock);
+
+	*begin = ctx->size/ctx->threads * w->id;
+	*end = w->id + 1 < ctx->threads ?
+		ctx->size/ctx->threads * (w->id + 1) : ctx->size;
+
+	return ctx;
+}
+
+/*
+ * Turns the digit counts of all threads into scatter offsets. A pass in which
+ * all keys have the same digit would only copy the array, it is skipped.
+ */
+static void psort_offsets(struct psort_ctx *ctx) {
+	size_t digit, pos, count;
+	unsigned t;
+
+	ctx->skip = 0;
+	for (digit = 0, pos = 0; digit < PSORT_RADIX; digit++) {
+		ctx->start[digit] = pos;
+		for (t = 0; t < ctx->threads; t++)
+			pos += ctx->hist[t][digit];
+		if (pos - ctx->start[digit] == ctx->size)
+			ctx->skip = 1;
+	}
+	ctx->start[PSORT_RADIX] = pos;
+	if (ctx->skip)
+		return;
+
+	for (digit = 0, pos = 0; digit < PSORT_RADIX; digit++) {
+		for (t = 0; t < ctx->threads; t++) {
+			count = ctx->hist[t][digit];
+			ctx->hist[t][digit] = pos;
+			pos += count;
+		}
+	}
+}
+
+/* 8-bit keys: count, then every thread fills its slice from the buckets */
+static void *psort_worker_u8(void *arg) {
+	struct psort_worker *w = arg;
+	size_t begin, end, from, to;
+	struct psort_ctx *ctx = psort_start(w, &begin, &end);
+	uint8_t *array = ctx->array;
+	size_t *hist = ctx->hist[w->id];
+	size_t i;
+	unsigned key;
+
+	for (i = begin; i < end; i++)
+		hist[array[i] ^ 0xFF]++;
+	pthread_barrier_wait(&ctx->barrier);
+	if (w->id == 0)
+		psort_offsets(ctx);
+	pthread_barrier_wait(&ctx->barrier);
+
+	for (key = 0; key < PSORT_RADIX; key++) {
+		from = ctx->start[key] > begin ? ctx->start[key] : begin;
+		to = ctx->start[key + 1] < end ? ctx->start[key + 1] : end;
+		if (from < to)
+			memset(array + from, key ^ 0xFF, to - from);
+	}
+
+	return NULL;
+}
+
+#define PSORT_DEFINE_RADIX(SFX, T, KEY)					\
+static void *psort_worker_##SFX(void *arg) {					\
+	struct psort_worker *w = arg;						\
+	size_t begin, end;							\
+	struct psort_ctx *ctx = psort_start(w, &begin, &end);			\
+	T (*line)[PSORT_LINE/sizeof(T)] = (T (*)[PSORT_LINE/sizeof(T)])w->line;	\
+	size_t *hist = ctx->hist[w->id];					\
+	uint8_t fill[PSORT_RADIX];						\
+	T *src = ctx->array;							\
+	T *dst = ctx->scratch;							\
+	T *tmp;									\
+	unsigned shift, digit;							\
+	size_t i;								\
+										\
+	for (shift = 0; shift < 8 * sizeof(T); shift += 8) {			\
+		memset(hist, 0, PSORT_RADIX * sizeof(size_t));			\
+		for (i = begin; i < end; i++)					\
+			hist[(KEY(src[i]) >> shift) & 0xFF]++;			\
+		pthread_barrier_wait(&ctx->barrier);				\
+		if (w->id == 0)							\
+			psort_offsets(ctx);					\
+		pthread_barrier_wait(&ctx->barrier);				\
+		if (ctx->skip)							\
+			continue;						\
+										\
+		memset(fill, 0, sizeof(fill));					\
+		for (i = begin; i < end; i++) {					\
+			digit = (KEY(src[i]) >> shift) & 0xFF;			\
+			line[digit][fill[digit]++] = src[i];			\
+			if (fill[digit] == PSORT_LINE/sizeof(T)) {		\
+				memcpy(dst + hist[digit], line[digit], PSORT_LINE); \
+				hist[digit] += PSORT_LINE/sizeof(T);		\
+				fill[digit] = 0;				\
+			}							\
+		}								\
+		for (digit = 0; digit < PSORT_RADIX; digit++)			\
+			memcpy(dst + hist[digit], line[digit],			\
+				fill[digit] * sizeof(T));			\
+		pthread_barrier_wait(&ctx->barrier);				\
+		tmp = src;							\
+		src = dst;							\
+		dst = tmp;							\
+	}									\
+										\
+	/* an odd number of scattering passes leaves the result in scratch */	\
+	if (src != ctx->array)							\
+		memcpy((T *)ctx->array + begin, src + begin,			\
+			(end - begin) * sizeof(T));				\
+										\
+	return NULL;								\
+}
+
+static uint32_t psort_key_f32(float v) {
+	uint32_t bits;
+
+	memcpy(&bits, &v, sizeof(bits));
+
+	return bits & 0x80000000 ? bits : bits ^ 0x7FFFFFFF;
+}
+
+#define PSORT_KEY_i16(v) ((uint16_t)(v) ^ 0x7FFF)
+#define PSORT_KEY_i32(v) ((uint32_t)(v) ^ 0x7FFFFFFF)
+#define PSORT_KEY_f32(v) psort_key_f32(v)
+
+PSORT_DEFINE_RADIX(i16, int16_t, PSORT_KEY_i16)
+PSORT_DEFINE_RADIX(i32, int32_t, PSORT_KEY_i32)
+PSORT_DEFINE_RADIX(f32, float, PSORT_KEY_f32)
+
+static int psort_run(void *array, size_t size, size_t elem, unsigned threads,
+	void *(*worker)(void *)) {
+	struct psort_ctx ctx;
+	struct psort_worker *workers;
+	unsigned i;
+	int ret = 0;
+
+	if (threads == 0)
+		threads = pstats_threads();
+	if (threads > size/PSORT_MIN_SLICE)
+		threads = size/PSORT_MIN_SLICE ? size/PSORT_MIN_SLICE : 1;
+
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.array = array;
+	ctx.size = size;
+	ctx.hist = calloc(threads, sizeof(*ctx.hist));
+	workers = calloc(threads, sizeof(*workers));
+	if (ctx.hist == NULL || workers == NULL)
+		ret = ENOMEM;
+
+	/* 8-bit keys are counted, wider keys need a scratch copy and lines */
+	for (i = 0; !ret && elem > 1 && i < threads; i++) {
+		workers[i].line = malloc(PSORT_RADIX * PSORT_LINE);
+		if (workers[i].line == NULL)
+			ret = ENOMEM;
+	}
+	if (!ret && elem > 1 && (ctx.scratch = malloc(size * elem)) == NULL)
+		ret = ENOMEM;
+	if (ret)
+		goto out;
+
+	pthread_mutex_init(&ctx.lock, NULL);
+	pthread_cond_init(&ctx.go, NULL);
+	for (i = 0; i < threads; i++) {
+		workers[i].ctx = &ctx;
+		workers[i].id = i;
+		if (i && pthread_create(&workers[i].thread, NULL, worker,
+			&workers[i]))
+			break;
+	}
+
+	/* threads which could not be created leave their slices to the others */
+	pthread_mutex_lock(&ctx.lock);
+	ctx.threads = i;
+	pthread_barrier_init(&ctx.barrier, NULL, ctx.threads);
+	ctx.started = 1;
+	pthread_cond_broadcast(&ctx.go);
+	pthread_mutex_unlock(&ctx.lock);
+
+	worker(&workers[0]);
+	for (i = 1; i < ctx.threads; i++)
+		pthread_join(workers[i].thread, NULL);
+
+	pthread_barrier_destroy(&ctx.barrier);
+	pthread_cond_destroy(&ctx.go);
+	pthread_mutex_destroy(&ctx.lock);
+
+out:
+	for (i = 0; workers != NULL && i < threads; i++)
+		free(workers[i].line);
+	free(workers);
+	free(ctx.scratch);
+	free(ctx.hist);
+
+	return ret;
+}
+
+int psort_u8(uint8_t *array, size_t size, unsigned threads) {
+
+	return psort_run(array, size, sizeof(*array), threads, psort_worker_u8);
+}
+
+int psort_i16(int16_t *array, size_t size, unsigned threads) {
+
+	return psort_run(array, size, sizeof(*array), threads, psort_worker_i16);
+}
+
+int psort_i32(int32_t *array, size_t size, unsigned threads) {
+
+	return psort_run(array, size, sizeof(*array), threads, psort_worker_i32);
+}
+
+int psort_f32(float *array, size_t size, unsigned threads) {
+
+	return psort_run(array, size, sizeof(*array), threads, psort_worker_f32);
+}
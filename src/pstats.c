@@ -0,0 +1,252 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file: pstats.c
+ * @brief: Parallel statistics over large host-side data sets.
+ *
+ * The data set is cut into one contiguous slice per worker thread. Each
+ * worker counts its slice into a private histogram, so the workers share
+ * no written memory until the histograms are merged by the caller. Sum,
+ * minimum and maximum are derived from the merged histogram, which keeps
+ * them exact for any number of threads.
+ *
+ * @author: Valentina Krasnobaeva
+ * @date: 10/18/2026
+ *
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "platform.h"
+#include "pstats.h"
+
+struct pstats_slice {
+	const void *array;
+	size_t begin;
+	size_t end;
+	size_t bins;
+	size_t *hist;
+	pthread_t thread;
+};
+
+/*
+ * Repeated values make consecutive increments of one counter depend on each
+ * other. u8 spreads them over four sub-histograms, i16 has enough bins to
+ * make runs of the same counter unlikely.
+ */
+static void *pstats_worker_u8(void *arg) {
+	struct pstats_slice *slice = arg;
+	const uint8_t *ptr = (const uint8_t *)slice->array + slice->begin;
+	const uint8_t *end = (const uint8_t *)slice->array + slice->end;
+	size_t sub[4][UINT8_MAX + 1] = { { 0 } };
+	size_t i;
+
+	while (ptr + 4 <= end) {
+		sub[0][ptr[0]]++;
+		sub[1][ptr[1]]++;
+		sub[2][ptr[2]]++;
+		sub[3][ptr[3]]++;
+		ptr += 4;
+	}
+	while (ptr < end)
+		sub[0][*ptr++]++;
+
+	for (i = 0; i <= UINT8_MAX; i++)
+		slice->hist[i] += sub[0][i] + sub[1][i] + sub[2][i] + sub[3][i];
+
+	return NULL;
+}
+
+static void *pstats_worker_i16(void *arg) {
+	struct pstats_slice *slice = arg;
+	const int16_t *ptr = (const int16_t *)slice->array + slice->begin;
+	const int16_t *end = (const int16_t *)slice->array + slice->end;
+
+	while (ptr < end)
+		slice->hist[(int32_t)*ptr++ - INT16_MIN]++;
+
+	return NULL;
+}
+
+unsigned pstats_threads(void) {
+	const char *env = getenv("PSTATS_THREADS");
+	long n;
+
+	if (env != NULL && (n = strtol(env, NULL, 10)) > 0)
+		return (unsigned)n;
+
+	n = sysconf(_SC_NPROCESSORS_ONLN);
+
+	return n > 0 ? (unsigned)n : 1;
+}
+
+static int pstats_collect(struct pstats *st, const void *array, size_t size,
+	unsigned threads, size_t bins, int32_t offset,
+	void *(*worker)(void *)) {
+	struct pstats_slice *slices;
+	unsigned i;
+	size_t j, seen;
+	int ret = 0;
+
+	st->count = size;
+	st->sum = 0;
+	st->min = 0;
+	st->max = 0;
+	st->offset = offset;
+	st->bins = bins;
+
+	if (threads == 0)
+		threads = pstats_threads();
+	if (threads > size/PSTATS_MIN_SLICE)
+		threads = size/PSTATS_MIN_SLICE ? size/PSTATS_MIN_SLICE : 1;
+
+	st->hist = calloc(bins, sizeof(size_t));
+	slices = calloc(threads, sizeof(*slices));
+	if (st->hist == NULL || slices == NULL) {
+		free(slices);
+		pstats_free(st);
+		return ENOMEM;
+	}
+
+	/* slice 0 counts straight into the result and runs in this thread */
+	for (i = 0; i < threads; i++) {
+		slices[i].array = array;
+		slices[i].begin = size/threads * i;
+		slices[i].end = i + 1 < threads ? size/threads * (i + 1) : size;
+		slices[i].bins = bins;
+		slices[i].hist = i ? calloc(bins, sizeof(size_t)) : st->hist;
+		if (slices[i].hist == NULL) {
+			ret = ENOMEM;
+			goto out;
+		}
+	}
+
+	for (i = 1; i < threads; i++) {
+		if (pthread_create(&slices[i].thread, NULL, worker, &slices[i])) {
+			PRINTF("WARN: %s: worker %u runs inline\n", __func__, i);
+			slices[i].thread = pthread_self();
+			worker(&slices[i]);
+		}
+	}
+	worker(&slices[0]);
+
+	for (i = 1; i < threads; i++) {
+		if (!pthread_equal(slices[i].thread, pthread_self()))
+			pthread_join(slices[i].thread, NULL);
+		for (j = 0; j < bins; j++)
+			st->hist[j] += slices[i].hist[j];
+	}
+
+	for (j = 0, seen = 0; j < bins; j++) {
+		if (st->hist[j] == 0)
+			continue;
+		if (seen == 0)
+			st->min = offset + (int32_t)j;
+		seen += st->hist[j];
+		st->max = offset + (int32_t)j;
+		st->sum += (int64_t)st->max * (int64_t)st->hist[j];
+	}
+
+out:
+	for (i = 1; i < threads; i++)
+		free(slices[i].hist);
+	free(slices);
+	if (ret)
+		pstats_free(st);
+
+	return ret;
+}
+
+int pstats_collect_u8(struct pstats *st, const uint8_t *array, size_t size,
+	unsigned threads) {
+
+	return pstats_collect(st, array, size, threads, UINT8_MAX + 1, 0,
+		pstats_worker_u8);
+}
+
+int pstats_collect_i16(struct pstats *st, const int16_t *array,
+	size_t size, unsigned threads) {
+
+	return pstats_collect(st, array, size, threads, UINT16_MAX + 1,
+		INT16_MIN, pstats_worker_i16);
+}
+
+/* Returns the k-th smallest sample, counted from 0 */
+static int32_t pstats_nth(const struct pstats *st, size_t k) {
+	size_t j;
+
+	for (j = 0; j < st->bins; j++) {
+		if (k < st->hist[j])
+			break;
+		k -= st->hist[j];
+	}
+
+	return st->offset + (int32_t)j;
+}
+
+int32_t pstats_percentile(const struct pstats *st, uint8_t p) {
+	size_t rank;
+
+	if (st->count == 0)
+		return 0;
+	if (p > 100)
+		p = 100;
+	/* nearest-rank method, same as find_percentile() */
+	rank = (size_t)((p * (uint64_t)st->count + 99)/100);
+
+	return pstats_nth(st, rank ? rank - 1 : 0);
+}
+
+int32_t pstats_median(const struct pstats *st) {
+	size_t half = st->count/2;
+
+	if (st->count == 0)
+		return 0;
+	if (st->count % 2)
+		return pstats_nth(st, half);
+
+	return (int32_t)(((int64_t)pstats_nth(st, half - 1) +
+		pstats_nth(st, half))/2);
+}
+
+int32_t pstats_mean(const struct pstats *st) {
+
+	if (st->count == 0)
+		return 0;
+
+	return (int32_t)(st->sum/(int64_t)st->count);
+}
+
+void pstats_print(const struct pstats *st) {
+	PRINTF("======================\n");
+	PRINTF("  Samples = %lu\n", (unsigned long)st->count);
+	PRINTF("  Maximum value = %" PRId32 "\n", st->max);
+	PRINTF("  Minimum value = %" PRId32 "\n", st->min);
+	PRINTF("  Median = %" PRId32 "\n", pstats_median(st));
+	PRINTF("  95th percentile = %" PRId32 "\n", pstats_percentile(st, 95));
+	PRINTF("  99th percentile = %" PRId32 "\n", pstats_percentile(st, 99));
+	if (st->count == 0)
+		PRINTF("  ERROR: Mean: cannot divide by zero, please check array len\n");
+	else
+		PRINTF("  Mean = %" PRId32 "\n", pstats_mean(st));
+	PRINTF("======================\n");
+}
+
+void pstats_free(struct pstats *st) {
+
+	free(st->hist);
+	st->hist = NULL;
+	st->bins = 0;
+}
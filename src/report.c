@@ -0,0 +1,103 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file report.c
+ * @brief Zero-allocation statistics report writer
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include "data.h"
+#include "memory.h"
+#include "report.h"
+#include "stats.h"
+
+/* Same layout as print_array() */
+#define COLUMNS (4)
+
+static void report_bytes(struct report *rp, const uint8_t *src, size_t len) {
+	size_t room = rp->size - 1 - rp->len;
+
+	if (len > room) {
+		len = room;
+		rp->truncated = 1;
+	}
+	my_memcopy((uint8_t *)src, rp->buf + rp->len, len);
+	rp->len += len;
+	*(rp->buf + rp->len) = '\0';
+}
+
+void report_init(struct report *rp, uint8_t *buf, size_t size) {
+
+	rp->buf = buf;
+	rp->size = size;
+	rp->len = 0;
+	rp->truncated = 0;
+	*buf = '\0';
+}
+
+void report_str(struct report *rp, const char *str) {
+	const char *end = str;
+
+	while (*end)
+		end++;
+	report_bytes(rp, (const uint8_t *)str, end - str);
+}
+
+void report_int(struct report *rp, int32_t value, uint32_t base) {
+	uint8_t str[MAX_LEN];
+	uint8_t len;
+
+	if (base != BASE_2 && base != BASE_10 && base != BASE_16)
+		return;
+	/* my_itoa() counts the '\0' */
+	len = my_itoa(value, str, base);
+	report_bytes(rp, str, len - 1);
+}
+
+size_t report_array(struct report *rp, uint8_t *array, size_t size) {
+	size_t i;
+
+	report_str(rp, "=============\n");
+	for (i = 0; i < size; i++) {
+		report_str(rp, "\ttest[");
+		report_int(rp, (int32_t)i, BASE_10);
+		report_str(rp, "] = ");
+		report_int(rp, *(array + i), BASE_10);
+		report_str(rp, (i+1)%COLUMNS ? "\t" : "\n");
+	}
+
+	return rp->len;
+}
+
+size_t report_statistics(struct report *rp, uint8_t *array, size_t size) {
+
+	report_str(rp, "======================\n");
+	report_str(rp, "  Maximum value = ");
+	report_int(rp, find_maximum(array, size), BASE_10);
+	report_str(rp, "\n  Minimum value = ");
+	report_int(rp, find_minimum(array, size), BASE_10);
+	report_str(rp, "\n  Median = ");
+	report_int(rp, find_median(array, size), BASE_10);
+	if (size == 0) {
+		report_str(rp, "\n  ERROR: Mean: cannot divide by zero, please check array len\n");
+	} else {
+		report_str(rp, "\n  Mean = ");
+		report_int(rp, find_mean(array, size), BASE_10);
+		report_str(rp, "\n");
+	}
+	report_str(rp, "======================\n");
+
+	return rp->len;
+}
@@ -36,6 +36,9 @@
 
 #include <stdint.h>
 
+/* End of SRAM_DATA, defined in msp432p401r.lds */
+extern uint32_t __StackTop;
+
 /* Forward declaration of the default fault handlers. */
 extern void Reset_Handler(void);
 extern void NMI_Handler(void);
@@ -94,10 +97,9 @@ extern void PORT6_IRQHandler(void);
 /* Interrupt vector table.  Note that the proper constructs must be placed on this to */
 /* ensure that it ends up at physical address 0x0000.0000 or at the start of          */
 /* the program if located at a start address other than 0.                            */
-void (* const interruptVectors[])(void) __attribute__ ((section (".intvecs"))) =
+void (* const interruptVectors[])(void) __attribute__ ((section (".intvecs"), used)) =
 {
-    (void (*)(void))((uint32_t)0x20004000),
-                                            /* The initial stack pointer */
+    (void (*)(void))&__StackTop,            /* The initial stack pointer */
     &Reset_Handler,                         /* The reset handler         */
     &NMI_Handler,                           /* The NMI handler           */
     &HardFault_Handler,                     /* The hard fault handler    */
@@ -21,15 +21,415 @@
  * @date: 09/02/2020
  *
  */
+#define LOG_MODULE_LEVEL STATS_LOG_LEVEL
+
+#include <inttypes.h>
 #include <stddef.h>
 #include <stdint.h>
-#include "platform.h"
+#include "log.h"
+#include "memory.h"
 #include "stats.h"
 
 /* Size of the Data Set */
 #define SIZE (40)
 #define COLUMNS (4)
 
+/* Partitions up to this size are finished off with an insertion sort */
+#define SELECT_SMALL (16)
+
+#define STATS_SWAP(T, a, b) do { T tmp_ = (a); (a) = (b); (b) = tmp_; } while (0)
+
+/*
+ * Introselect template: quickselect with a median-of-three pivot and a Hoare
+ * partition. Every partition step spends one unit of a 2*log2(n) depth budget;
+ * when it runs out the remaining range is heap sorted, which bounds the worst
+ * case by O(n log n) while the expected cost stays O(n). Elements are ordered
+ * from small to large, like the nth_element of the C++ library.
+ */
+#define STATS_DEFINE_SELECT(SFX, T, WIDE)					\
+static void insertion_sort_##SFX(T * array, size_t size) {			\
+	size_t i, j;								\
+	T key;									\
+	for (i = 1; i < size; i++) {						\
+		key = array[i];							\
+		for (j = i; j > 0 && key < array[j-1]; j--)			\
+			array[j] = array[j-1];					\
+		array[j] = key;							\
+	}									\
+}										\
+										\
+static void sift_down_##SFX(T * array, size_t root, size_t size) {		\
+	size_t child;								\
+	while ((child = 2 * root + 1) < size) {					\
+		if (child + 1 < size && array[child] < array[child+1])		\
+			child++;						\
+		if (!(array[root] < array[child]))				\
+			return;							\
+		STATS_SWAP(T, array[root], array[child]);			\
+		root = child;							\
+	}									\
+}										\
+										\
+static void heap_sort_##SFX(T * array, size_t size) {				\
+	size_t i;								\
+	for (i = size/2; i > 0; i--)						\
+		sift_down_##SFX(array, i - 1, size);				\
+	for (i = size; i > 1; i--) {						\
+		STATS_SWAP(T, array[0], array[i-1]);				\
+		sift_down_##SFX(array, 0, i - 1);				\
+	}									\
+}										\
+										\
+void select_nth_##SFX(T * array, size_t size, size_t k) {			\
+	size_t lo = 0, hi = size;						\
+	size_t i, j, mid;							\
+	size_t depth = 0;							\
+	T pivot;								\
+										\
+	if (k >= size)								\
+		return;								\
+	for (i = size; i > 1; i >>= 1)						\
+		depth += 2;							\
+										\
+	/* [lo, hi) always holds the k-th position */				\
+	while (hi - lo > SELECT_SMALL) {					\
+		if (depth-- == 0) {						\
+			heap_sort_##SFX(array + lo, hi - lo);			\
+			return;							\
+		}								\
+		mid = lo + (hi - lo)/2;						\
+		if (array[mid] < array[lo])					\
+			STATS_SWAP(T, array[mid], array[lo]);			\
+		if (array[hi-1] < array[lo])					\
+			STATS_SWAP(T, array[hi-1], array[lo]);			\
+		if (array[hi-1] < array[mid])					\
+			STATS_SWAP(T, array[hi-1], array[mid]);			\
+		pivot = array[mid];						\
+										\
+		/* array[lo] and array[hi-1] stop both scans on the first pass */ \
+		i = lo;								\
+		j = hi - 1;							\
+		for (;;) {							\
+			while (array[i] < pivot)				\
+				i++;						\
+			while (pivot < array[j])				\
+				j--;						\
+			if (i >= j)						\
+				break;						\
+			STATS_SWAP(T, array[i], array[j]);			\
+			i++;							\
+			j--;							\
+		}								\
+										\
+		if (i == j) {							\
+			/* array[i] equals the pivot and is already in place */	\
+			if (k == i)						\
+				return;						\
+			if (k < i)						\
+				hi = i;						\
+			else							\
+				lo = i + 1;					\
+		} else if (k <= j) {						\
+			hi = j + 1;						\
+		} else {							\
+			lo = i;							\
+		}								\
+	}									\
+	insertion_sort_##SFX(array + lo, hi - lo);				\
+}										\
+										\
+T find_percentile_##SFX(T * array, size_t size, uint8_t p) {			\
+	size_t rank;								\
+										\
+	if (size == 0)								\
+		return 0;							\
+	if (p > 100)								\
+		p = 100;							\
+	/* nearest-rank method: ceil(p * size / 100), counted from 1 */	\
+	rank = (size_t)((p * (uint64_t)size + 99)/100);			\
+	if (rank)								\
+		rank--;							\
+	select_nth_##SFX(array, size, rank);					\
+	return array[rank];							\
+}										\
+										\
+T find_median_##SFX(T * array, size_t size) {					\
+	size_t i, half = size/2;						\
+	T lower;								\
+										\
+	if (size == 0)								\
+		return 0;							\
+	select_nth_##SFX(array, size, half);					\
+	if (size % 2)								\
+		return array[half];						\
+										\
+	/* the lower middle is the largest element left of the upper one */	\
+	lower = array[0];							\
+	for (i = 1; i < half; i++)						\
+		if (lower < array[i])						\
+			lower = array[i];					\
+	return (T)(((WIDE)lower + array[half])/2);				\
+}
+
+/*
+ * Reductions. SCALAR walks the array once keeping max, min and a wide sum.
+ * SIMD keeps four independent lanes in GCC vector registers (SSE on the host,
+ * lowered to plain FPU code on the Cortex-M4F) and folds them at the end.
+ */
+#define STATS_DEFINE_REDUCE_SCALAR(SFX, T, SUM)				\
+T find_maximum_##SFX(T * array, size_t size) {					\
+	T max;									\
+	if (size == 0)								\
+		return 0;							\
+	max = array[--size];							\
+	while (size--) {							\
+		if (array[size] > max)						\
+			max = array[size];					\
+	}									\
+	return max;								\
+}										\
+										\
+T find_minimum_##SFX(T * array, size_t size) {					\
+	T min;									\
+	if (size == 0)								\
+		return 0;							\
+	min = array[--size];							\
+	while (size--) {							\
+		if (array[size] < min)						\
+			min = array[size];					\
+	}									\
+	return min;								\
+}										\
+										\
+T find_mean_##SFX(T * array, size_t size) {					\
+	SUM sum = 0;								\
+	size_t i;								\
+	if (size == 0)								\
+		return 0;							\
+	for (i = 0; i < size; i++)						\
+		sum += array[i];						\
+	return (T)(sum/(SUM)size);						\
+}
+
+typedef float v4sf __attribute__((vector_size(16)));
+typedef int32_t v4si __attribute__((vector_size(16)));
+/* same lanes, but loadable from any element of a float array */
+typedef float v4sf_u __attribute__((vector_size(16), aligned(4), may_alias));
+
+#define STATS_DEFINE_REDUCE_SIMD(SFX, T, SUM)					\
+T find_maximum_##SFX(T * array, size_t size) {					\
+	v4sf lanes, v;								\
+	v4si gt;								\
+	T max;									\
+	size_t i;								\
+	if (size == 0)								\
+		return 0;							\
+	lanes = (v4sf){ array[0], array[0], array[0], array[0] };		\
+	for (i = 0; i < (size & ~(size_t)3); i += 4) {				\
+		v = *(const v4sf_u *)(array + i);				\
+		gt = v > lanes;							\
+		lanes = (v4sf)(((v4si)v & gt) | ((v4si)lanes & ~gt));		\
+	}									\
+	max = lanes[0];								\
+	for (; i < size; i++)							\
+		if (array[i] > max)						\
+			max = array[i];						\
+	for (i = 1; i < 4; i++)							\
+		if (lanes[i] > max)						\
+			max = lanes[i];						\
+	return max;								\
+}										\
+										\
+T find_minimum_##SFX(T * array, size_t size) {					\
+	v4sf lanes, v;								\
+	v4si lt;								\
+	T min;									\
+	size_t i;								\
+	if (size == 0)								\
+		return 0;							\
+	lanes = (v4sf){ array[0], array[0], array[0], array[0] };		\
+	for (i = 0; i < (size & ~(size_t)3); i += 4) {				\
+		v = *(const v4sf_u *)(array + i);				\
+		lt = v < lanes;							\
+		lanes = (v4sf)(((v4si)v & lt) | ((v4si)lanes & ~lt));		\
+	}									\
+	min = lanes[0];								\
+	for (; i < size; i++)							\
+		if (array[i] < min)						\
+			min = array[i];						\
+	for (i = 1; i < 4; i++)							\
+		if (lanes[i] < min)						\
+			min = lanes[i];						\
+	return min;								\
+}										\
+										\
+T find_mean_##SFX(T * array, size_t size) {					\
+	SUM sum[4] = { 0, 0, 0, 0 };						\
+	size_t i;								\
+	if (size == 0)								\
+		return 0;							\
+	for (i = 0; i < (size & ~(size_t)3); i += 4) {				\
+		sum[0] += array[i];						\
+		sum[1] += array[i+1];						\
+		sum[2] += array[i+2];						\
+		sum[3] += array[i+3];						\
+	}									\
+	for (; i < size; i++)							\
+		sum[0] += array[i];						\
+	return (T)((sum[0] + sum[1] + sum[2] + sum[3])/(SUM)size);		\
+}
+
+/*
+ * Sorting from large to small. Short arrays always take the insertion sort
+ * of the select template. COUNTING rewrites bytes straight from a 256-entry
+ * histogram. RADIX does an LSD byte-wise radix sort of 16-bit keys through a
+ * scratch buffer from reserve_words() and falls back to HEAP if it cannot be
+ * allocated. HEAP needs no auxiliary memory at all. On HOST, large arrays of
+ * any type go to the parallel radix sort of psort.c first.
+ */
+#if defined (HOST)
+#include "psort.h"
+
+#define STATS_SORT_PARALLEL(SFX, array, size)					\
+	if (size >= PSORT_MIN_SIZE && psort_##SFX(array, size, 0) == 0)		\
+		return;
+#else
+#define STATS_SORT_PARALLEL(SFX, array, size)
+#endif
+
+#define STATS_DEFINE_SORT_HEAP(SFX, T)						\
+void sort_array_##SFX(T * array, size_t size) {				\
+	STATS_SORT_PARALLEL(SFX, array, size)					\
+	if (size <= SELECT_SMALL)						\
+		insertion_sort_##SFX(array, size);				\
+	else									\
+		heap_sort_##SFX(array, size);					\
+	reverse_##SFX(array, size);						\
+}
+
+#define STATS_DEFINE_SORT_COUNTING(SFX, T)					\
+void sort_array_##SFX(T * array, size_t size) {				\
+	size_t count[UINT8_MAX + 1] = { 0 };					\
+	size_t i;								\
+	STATS_SORT_PARALLEL(SFX, array, size)					\
+	if (size <= SELECT_SMALL) {						\
+		insertion_sort_##SFX(array, size);				\
+		reverse_##SFX(array, size);					\
+		return;								\
+	}									\
+	for (i = 0; i < size; i++)						\
+		count[array[i]]++;						\
+	for (i = UINT8_MAX + 1; i--; ) {					\
+		my_memset(array, count[i], (uint8_t)i);				\
+		array += count[i];						\
+	}									\
+}
+
+#define STATS_DEFINE_SORT_RADIX(SFX, T)					\
+void sort_array_##SFX(T * array, size_t size) {				\
+	size_t count[UINT8_MAX + 1];						\
+	size_t i, pos, tmp;							\
+	unsigned shift;								\
+	T *src = array;								\
+	T *dst;									\
+	T *scratch;								\
+										\
+	STATS_SORT_PARALLEL(SFX, array, size)					\
+	if (size <= SELECT_SMALL) {						\
+		insertion_sort_##SFX(array, size);				\
+		reverse_##SFX(array, size);					\
+		return;								\
+	}									\
+	scratch = (T *)reserve_words((size * sizeof(T) + 3)/4);			\
+	if (scratch == NULL) {							\
+		heap_sort_##SFX(array, size);					\
+		reverse_##SFX(array, size);					\
+		return;								\
+	}									\
+										\
+	/* flipping all value bits but the sign bit turns descending signed */	\
+	/* order into ascending unsigned order of the keys */			\
+	dst = scratch;								\
+	for (shift = 0; shift < 8 * sizeof(T); shift += 8) {			\
+		my_memzero((uint8_t *)count, sizeof(count));			\
+		for (i = 0; i < size; i++)					\
+			count[(RADIX_KEY_##SFX(src[i]) >> shift) & 0xFF]++;	\
+		for (i = 0, pos = 0; i <= UINT8_MAX; i++) {			\
+			tmp = count[i];						\
+			count[i] = pos;						\
+			pos += tmp;						\
+		}								\
+		for (i = 0; i < size; i++)					\
+			dst[count[(RADIX_KEY_##SFX(src[i]) >> shift) & 0xFF]++] = src[i]; \
+		dst = src;							\
+		src = src == array ? scratch : array;				\
+	}									\
+	/* an even number of passes leaves the result in array */		\
+	free_words((int32_t *)scratch);						\
+}
+
+#define RADIX_KEY_i16(v) ((uint16_t)(v) ^ 0x7FFF)
+
+#if LOG_ENABLED(DEBUG)
+#define STATS_PRINT_ELEMENTS(FMT)						\
+	size_t i = 0;								\
+	LOG_DEBUG("=============\n");						\
+	while (i < size) {							\
+		if ((i+1)%COLUMNS)						\
+			LOG_DEBUG("\ttest[%lu] = " FMT "\t",			\
+				(unsigned long)i, array[i]);			\
+		else								\
+			LOG_DEBUG("\ttest[%lu] = " FMT "\n",			\
+				(unsigned long)i, array[i]);			\
+		i++;							\
+	}
+#else
+#define STATS_PRINT_ELEMENTS(FMT)
+#endif
+
+#define STATS_DEFINE_PRINT(SFX, T, FMT)					\
+void print_array_##SFX(T * array, size_t size) {				\
+	STATS_PRINT_ELEMENTS(FMT)						\
+}										\
+										\
+void print_statistics_##SFX(T * array, size_t size) {				\
+	LOG_INFO("======================\n");					\
+	LOG_INFO("  Maximum value = " FMT "\n", find_maximum_##SFX(array, size));	\
+	LOG_INFO("  Minimum value = " FMT "\n", find_minimum_##SFX(array, size));	\
+	LOG_INFO("  Median = " FMT "\n", find_median_##SFX(array, size));		\
+	if (size == 0)								\
+		LOG_ERROR("  ERROR: Mean: cannot divide by zero, please check array len\n"); \
+	else									\
+		LOG_INFO("  Mean = " FMT "\n", find_mean_##SFX(array, size));	\
+	LOG_INFO("======================\n");					\
+}
+
+#define STATS_DEFINE_REVERSE(SFX, T)						\
+static void reverse_##SFX(T * array, size_t size) {				\
+	T *end = array + size;							\
+	while (array + 1 < end) {						\
+		end--;								\
+		STATS_SWAP(T, *array, *end);					\
+		array++;							\
+	}									\
+}
+
+/*
+ * One instantiation per element type: WIDE holds the sum of two elements,
+ * SUM accumulates the whole array, SORT and REDUCE pick the algorithms.
+ */
+#define STATS_DEFINE(SFX, T, WIDE, SUM, FMT, SORT, REDUCE)			\
+	STATS_DEFINE_SELECT(SFX, T, WIDE)					\
+	STATS_DEFINE_REVERSE(SFX, T)						\
+	STATS_DEFINE_REDUCE_##REDUCE(SFX, T, SUM)				\
+	STATS_DEFINE_SORT_##SORT(SFX, T)					\
+	STATS_DEFINE_PRINT(SFX, T, FMT)
+
+STATS_DEFINE(u8, uint8_t, uint32_t, uint64_t, "%d", COUNTING, SCALAR)
+STATS_DEFINE(i16, int16_t, int32_t, int64_t, "%d", RADIX, SCALAR)
+STATS_DEFINE(i32, int32_t, int64_t, int64_t, "%" PRId32, HEAP, SCALAR)
+STATS_DEFINE(f32, float, double, double, "%f", HEAP, SIMD)
+
 void show_stats() {
 
 	uint8_t test[SIZE] = { 34, 201, 190, 154,   8, 194,   2,   6,
@@ -44,67 +444,33 @@ void show_stats() {
 }
 
 void print_array(uint8_t * array, size_t size) {
-
-#ifdef VERBOSE
-	uint8_t i = 0;
-	PRINTF("=============\n");
-	while (i < size) {
-		if ((i+1)%COLUMNS)
-			PRINTF("\ttest[%d] = %d\t", i, array[i]);
-		else
-			PRINTF("\ttest[%d] = %d\n", i, array[i]);
-		i++;
-	}
-#endif
-
+	print_array_u8(array, size);
 }
 
 void sort_array(uint8_t * array, size_t size) {
-	uint8_t i, j;
-	uint8_t tmp;
-	for (i = 0; i < size; ++i) {
-		for (j = i + 1; j < size; ++j) {
-			if (array[i] < array[j]) {
-				tmp= array[i];
-				array[i] = array[j];
-				array[j] = tmp;
-			}
-		}
-	}
-
+	sort_array_u8(array, size);
 }
 
 uint8_t find_maximum(uint8_t * array, size_t size) {
-	return array[0];
+	return find_maximum_u8(array, size);
 };
 
 uint8_t find_minimum(uint8_t * array, size_t size) {
-	return array[size-1];
+	return find_minimum_u8(array, size);
 };
 
 uint8_t find_median(uint8_t * array, size_t size) {
-	return (array[size/2-1] + array[size/2])/2;
+	return find_median_u8(array, size);
+};
+
+uint8_t find_percentile(uint8_t * array, size_t size, uint8_t p) {
+	return find_percentile_u8(array, size, p);
 };
 
 uint8_t find_mean(uint8_t * array, size_t size) {
-	uint8_t i = 0;
-	uint8_t sum = 0;
-	while( i < size ) {
-		sum += array[i];
-		i++;
-	}
-	return sum/size;
+	return find_mean_u8(array, size);
 };
 
 void print_statistics(uint8_t * array, size_t size) {
-	PRINTF("======================\n");
-	PRINTF("  Maximum value = %d\n", find_maximum(array, size));
-	PRINTF("  Minimum value = %d\n", find_minimum(array, size));
-	PRINTF("  Median = %d\n", find_median(array, size));
-	if (size == 0)
-		PRINTF("  ERROR: Mean: cannot divide by zero, please check array len\n");
-	else
-		PRINTF("  Mean = %d\n", find_mean(array, size));
-	PRINTF("======================\n");
-
+	print_statistics_u8(array, size);
 }
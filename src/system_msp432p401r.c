@@ -68,13 +68,25 @@
 //     <12000000> 12 MHz
 //     <24000000> 24 MHz
 //     <48000000> 48 MHz
+//  Can be given with -D__SYSTEM_CLOCK=..., see SYSTEM_CLOCK in the Makefile
+#ifndef __SYSTEM_CLOCK
 #define  __SYSTEM_CLOCK    3000000
+#endif
+
+#if (__SYSTEM_CLOCK != 1500000) && (__SYSTEM_CLOCK != 3000000) && \
+    (__SYSTEM_CLOCK != 12000000) && (__SYSTEM_CLOCK != 24000000) && \
+    (__SYSTEM_CLOCK != 48000000)
+#error "__SYSTEM_CLOCK must be 1500000, 3000000, 12000000, 24000000 or 48000000"
+#endif
 
 /*--------------------- Power Regulator Configuration -----------------------*/
 //  Power Regulator Mode
 //     <0> LDO
 //     <1> DC-DC
+//  Can be given with -D__REGULATOR=..., see REGULATOR and CLOCK in the Makefile
+#ifndef __REGULATOR
 #define __REGULATOR        0
+#endif
 
 /*----------------------------------------------------------------------------
    Define clocks, used for SystemCoreClockUpdate()
@@ -367,9 +379,9 @@ void SystemInit(void)
 	                                                       // Select MCLK as DCO source
     CS->KEY = 0;
 
-    // Set Flash Bank read buffering
+    // Set Flash Bank read buffering, both banks like flash_profile()
     FLCTL->BANK0_RDCTL = FLCTL->BANK0_RDCTL | (FLCTL_BANK0_RDCTL_BUFD | FLCTL_BANK0_RDCTL_BUFI);
-    FLCTL->BANK1_RDCTL = FLCTL->BANK1_RDCTL & ~(FLCTL_BANK1_RDCTL_BUFD | FLCTL_BANK1_RDCTL_BUFI);
+    FLCTL->BANK1_RDCTL = FLCTL->BANK1_RDCTL | (FLCTL_BANK1_RDCTL_BUFD | FLCTL_BANK1_RDCTL_BUFI);
 
     #elif (__SYSTEM_CLOCK == 48000000)                     // 48 MHz
     // Switches LDO VCORE0 to LDO VCORE1; mandatory for 48 MHz setting
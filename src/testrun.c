@@ -0,0 +1,126 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file testrun.c
+ * @brief Table driven test runner
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#define LOG_MODULE_LEVEL COURSE1_LOG_LEVEL
+
+#include <stddef.h>
+#include <stdint.h>
+#include "log.h"
+#include "memory.h"
+#include "testrun.h"
+#include "timing.h"
+
+static int8_t testrun_buffer_setup(struct testrun_ctx *ctx) {
+	uint32_t size = ctx->param < 0 ? -(uint32_t)ctx->param : ctx->param;
+	size_t i;
+
+	ctx->len = (size_t)size * 4 + TESTRUN_GUARD;
+	ctx->data = reserve_words((ctx->len + ctx->align + 3) / 4);
+	if (ctx->data == NULL)
+		return TESTRUN_FAIL;
+
+	ctx->buf = (uint8_t *)ctx->data + ctx->align;
+	for (i = 0; i < ctx->len; i++)
+		ctx->buf[i] = (uint8_t)i;
+
+	return TESTRUN_PASS;
+}
+
+static void testrun_buffer_teardown(struct testrun_ctx *ctx) {
+
+	free_words((int32_t *)ctx->data);
+	ctx->data = NULL;
+	ctx->buf = NULL;
+}
+
+const struct testrun_fixture testrun_buffer = {
+	testrun_buffer_setup,
+	testrun_buffer_teardown,
+};
+
+/* One case, returns TESTRUN_PASS or TESTRUN_FAIL */
+static int8_t testrun_case(const struct testrun_test *test,
+	struct testrun_ctx *ctx, uint64_t *ticks) {
+	uint64_t start;
+	int8_t ret;
+
+	if (test->fixture != NULL && test->fixture->setup(ctx) != TESTRUN_PASS)
+		return TESTRUN_FAIL;
+
+	start = timing_now();
+	ret = test->run(ctx);
+	*ticks += timing_now() - start;
+
+	if (test->fixture != NULL)
+		test->fixture->teardown(ctx);
+
+	return ret != TESTRUN_PASS ? TESTRUN_FAIL : TESTRUN_PASS;
+}
+
+uint16_t testrun(const struct testrun_test *tests, uint16_t count,
+	struct testrun_result *result) {
+	struct testrun_result total = { 0 };
+	const struct testrun_test *test;
+	struct testrun_ctx ctx;
+	uint32_t cases, failed;
+	uint16_t nparams, p;
+	uint8_t aligns, a;
+	uint64_t ticks, ns;
+
+	for (test = tests; test < tests + count; test++) {
+		nparams = test->nparams ? test->nparams : 1;
+		aligns = test->aligns ? test->aligns : 1;
+		cases = 0;
+		failed = 0;
+		ticks = 0;
+
+		for (p = 0; p < nparams; p++) {
+			for (a = 0; a < aligns; a++) {
+				ctx.param = test->params != NULL ?
+					test->params[p] : (int32_t)p;
+				ctx.align = a;
+				ctx.buf = NULL;
+				ctx.len = 0;
+				ctx.data = NULL;
+
+				cases++;
+				if (testrun_case(test, &ctx, &ticks) == TESTRUN_PASS)
+					continue;
+				failed++;
+				LOG_ERROR("  %s: FAILED for param %ld, align %u\n",
+					test->name, (long)ctx.param, ctx.align);
+			}
+		}
+
+		ns = timing_to_ns(ticks);
+		LOG_INFO("%-16s %6lu cases %6lu failed %10lu ns/case\n",
+			test->name, (unsigned long)cases, (unsigned long)failed,
+			(unsigned long)(ns / cases));
+
+		total.tests++;
+		total.tests_failed += failed != 0;
+		total.cases += cases;
+		total.cases_failed += failed;
+		total.ns += ns;
+	}
+
+	if (result != NULL)
+		*result = total;
+
+	return total.tests_failed;
+}
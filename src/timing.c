@@ -0,0 +1,97 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file timing.c
+ * @brief Platform independent time stamps for benchmarks and tests
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#define _POSIX_C_SOURCE 200809L
+
+#include <stddef.h>
+#include <stdint.h>
+#include "platform.h"
+#include "timing.h"
+
+#if defined (MSP432)
+
+extern uint32_t SystemCoreClock;
+
+/* Written by Reset_Handler */
+uint32_t timing_boot_init;
+uint32_t timing_boot_main;
+
+uint64_t timing_now(void) {
+	static uint32_t high;
+	static uint32_t last;
+	uint32_t now;
+
+	if (!(DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)) {
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+	}
+
+	now = DWT->CYCCNT;
+	if (now < last)
+		high++;
+	last = now;
+
+	return ((uint64_t)high << 32) | now;
+}
+
+uint64_t timing_to_ns(uint64_t ticks) {
+
+	return ticks * 1000000 / (SystemCoreClock / 1000);
+}
+
+uint32_t timing_boot(uint32_t *init) {
+
+	if (init != NULL)
+		*init = timing_boot_init;
+
+	return timing_boot_main;
+}
+
+#else
+
+#include <time.h>
+
+#ifndef __SYSTEM_CLOCK
+#define __SYSTEM_CLOCK (3000000)
+#endif
+
+uint32_t SystemCoreClock = __SYSTEM_CLOCK;
+
+uint64_t timing_now(void) {
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+uint64_t timing_to_ns(uint64_t ticks) {
+
+	return ticks;
+}
+
+uint32_t timing_boot(uint32_t *init) {
+
+	if (init != NULL)
+		*init = 0;
+
+	return 0;
+}
+
+#endif
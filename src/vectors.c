@@ -0,0 +1,158 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file vectors.c
+ * @brief Interrupt vector table in SRAM with runtime handler registration
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "platform.h"
+#include "vectors.h"
+
+/* VTOR needs the table aligned to its size rounded up to a power of 2 */
+#define VECTORS_ALIGN (512)
+
+#if VECTORS * 4 > VECTORS_ALIGN
+#error "VECTORS_ALIGN must hold the vector table"
+#endif
+
+#if defined (MSP432)
+
+extern void (* const interruptVectors[])(void);
+
+/* msp432p401r.lds places .vtable at the start of SRAM */
+static vectors_handler vectors_ram[VECTORS]
+	__attribute__((section(".vtable"), aligned(VECTORS_ALIGN)));
+
+static uint8_t vectors_active(void) {
+
+	return SCB->VTOR == (uint32_t)(uintptr_t)vectors_ram;
+}
+
+void vectors_init(void) {
+	uint32_t primask = __get_PRIMASK();
+	unsigned i;
+
+	if (vectors_active())
+		return;
+
+	__disable_irq();
+	for (i = 0; i < VECTORS; i++)
+		vectors_ram[i] = interruptVectors[i];
+	__DSB();
+	SCB->VTOR = (uint32_t)(uintptr_t)vectors_ram;
+	__DSB();
+	__ISB();
+	__set_PRIMASK(primask);
+}
+
+static vectors_handler vectors_flash(unsigned index) {
+
+	return interruptVectors[index];
+}
+
+/* The next exception entry fetches the new vector */
+static void vectors_sync(void) {
+
+	__DSB();
+}
+
+#else
+/******************************************************************************
+ HOST stand-in, a simulated table and dispatch
+******************************************************************************/
+static vectors_handler vectors_ram[VECTORS];
+static uint8_t vectors_ready;
+static uint32_t vectors_default_calls;
+
+static uint8_t vectors_active(void) {
+
+	return vectors_ready;
+}
+
+/* Default_Handler, which spins on MSP432 */
+static void vectors_default(void) {
+
+	vectors_default_calls++;
+}
+
+/* Reserved vectors of the system exceptions are 0 in interruptVectors[] */
+static vectors_handler vectors_flash(unsigned index) {
+
+	if (index < 2 || (index >= 7 && index <= 10) || index == 13)
+		return NULL;
+
+	return vectors_default;
+}
+
+void vectors_init(void) {
+	unsigned i;
+
+	if (vectors_active())
+		return;
+
+	for (i = 0; i < VECTORS; i++)
+		vectors_ram[i] = vectors_flash(i);
+	vectors_ready = 1;
+}
+
+static void vectors_sync(void) {
+}
+
+int vectors_dispatch(int irq) {
+	vectors_handler handler = vectors_get(irq);
+
+	if (handler == NULL)
+		return EINVAL;
+	handler();
+
+	return 0;
+}
+
+uint32_t vectors_unhandled(void) {
+
+	return vectors_default_calls;
+}
+
+#endif
+
+int vectors_set(int irq, vectors_handler handler, vectors_handler *old) {
+	unsigned index = (unsigned)(irq + VECTORS_SYSTEM);
+
+	if (irq < VECTORS_FIRST || irq >= VECTORS_IRQS)
+		return EINVAL;
+
+	vectors_init();
+	if (handler == NULL)
+		handler = vectors_flash(index);
+	if (old != NULL)
+		*old = vectors_ram[index];
+	vectors_ram[index] = handler;
+	vectors_sync();
+
+	return 0;
+}
+
+vectors_handler vectors_get(int irq) {
+
+	if (irq < VECTORS_FIRST || irq >= VECTORS_IRQS)
+		return NULL;
+
+	if (!vectors_active())
+		return vectors_flash(irq + VECTORS_SYSTEM);
+
+	return vectors_ram[irq + VECTORS_SYSTEM];
+}
@@ -0,0 +1,295 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file faultdecode.c
+ * @brief Host decoder for the crash reports of fault_report()
+ *
+ * Reads the console output of a boot, copies the "fault:" lines of the
+ * report and adds below them the exception name, the function and offset
+ * of pc, lr and every trace address from the symbol table of the ELF file
+ * (32 or 64 bit, little endian) that crashed, and the names of the bits
+ * set in CFSR and HFSR. Other lines are skipped.
+ *
+ * Use: faultdecode <ELF file> [console output]
+ *
+ * The console output is read from stdin when no file is given.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SHT_SYMTAB (2)
+#define STT_FUNC (2)
+#define EM_ARM (40)
+
+#define FAULTDECODE_LINE (512)
+#define FAULTDECODE_TOKENS (32)
+
+struct symbol {
+	uint64_t addr;
+	uint64_t size;
+	const char *name;
+};
+
+struct bit {
+	unsigned bit;
+	const char *name;
+};
+
+/* CFSR: MMFSR in bits 0 to 7, BFSR in 8 to 15, UFSR in 16 to 31 */
+static const struct bit cfsr_bits[] = {
+	{ 0, "IACCVIOL" }, { 1, "DACCVIOL" }, { 3, "MUNSTKERR" },
+	{ 4, "MSTKERR" }, { 5, "MLSPERR" }, { 7, "MMARVALID" },
+	{ 8, "IBUSERR" }, { 9, "PRECISERR" }, { 10, "IMPRECISERR" },
+	{ 11, "UNSTKERR" }, { 12, "STKERR" }, { 13, "LSPERR" },
+	{ 15, "BFARVALID" }, { 16, "UNDEFINSTR" }, { 17, "INVSTATE" },
+	{ 18, "INVPC" }, { 19, "NOCP" }, { 24, "UNALIGNED" },
+	{ 25, "DIVBYZERO" },
+};
+
+static const struct bit hfsr_bits[] = {
+	{ 1, "VECTTBL" }, { 30, "FORCED" }, { 31, "DEBUGEVT" },
+};
+
+static const char *const exception_names[] = {
+	"thread mode", "Reset", "NMI", "HardFault", "MemManage", "BusFault",
+	"UsageFault", NULL, NULL, NULL, NULL, "SVCall", "DebugMonitor", NULL,
+	"PendSV", "SysTick",
+};
+
+static struct symbol *symbols;
+static unsigned nsymbols;
+static int thumb;
+
+static uint64_t get(const uint8_t *p, unsigned size) {
+	uint64_t value = 0;
+
+	while (size--)
+		value = value << 8 | p[size];
+
+	return value;
+}
+
+static uint8_t *load(const char *name, size_t *size) {
+	uint8_t *buf;
+	FILE *in;
+	long len;
+
+	if ((in = fopen(name, "rb")) == NULL) {
+		perror(name);
+		return NULL;
+	}
+	fseek(in, 0, SEEK_END);
+	len = ftell(in);
+	fseek(in, 0, SEEK_SET);
+	buf = malloc(len > 0 ? len : 1);
+	if (buf != NULL && fread(buf, 1, len, in) != (size_t)len) {
+		free(buf);
+		buf = NULL;
+	}
+	fclose(in);
+	if (buf == NULL)
+		fprintf(stderr, "%s: can not read\n", name);
+	*size = len;
+
+	return buf;
+}
+
+/* Function symbols with a size, returns -1 if this is no ELF file */
+static int parse_symbols(const uint8_t *elf, size_t size) {
+	unsigned wide, shentsize, shnum, i, j, esize;
+	uint64_t shoff, off, len, link, strtab, strsz, name;
+	const uint8_t *sh, *sym;
+
+	if (size < 0x40 || memcmp(elf, "\177ELF", 4) != 0 || elf[5] != 1)
+		return -1;
+	wide = elf[4] == 2;
+	thumb = get(elf + 0x12, 2) == EM_ARM;
+	shoff = wide ? get(elf + 0x28, 8) : get(elf + 0x20, 4);
+	shentsize = get(elf + (wide ? 0x3A : 0x2E), 2);
+	shnum = get(elf + (wide ? 0x3C : 0x30), 2);
+	esize = wide ? 24 : 16;
+	if (shoff + (uint64_t)shentsize * shnum > size)
+		return -1;
+
+	for (i = 0; i < shnum; i++) {
+		sh = elf + shoff + (uint64_t)i * shentsize;
+		if (get(sh + 4, 4) != SHT_SYMTAB)
+			continue;
+		off = wide ? get(sh + 0x18, 8) : get(sh + 0x10, 4);
+		len = wide ? get(sh + 0x20, 8) : get(sh + 0x14, 4);
+		link = get(sh + (wide ? 0x28 : 0x18), 4);
+		if (off + len > size || link >= shnum)
+			continue;
+		sh = elf + shoff + link * shentsize;
+		strtab = wide ? get(sh + 0x18, 8) : get(sh + 0x10, 4);
+		strsz = wide ? get(sh + 0x20, 8) : get(sh + 0x14, 4);
+		if (strtab + strsz > size)
+			continue;
+
+		symbols = realloc(symbols, (nsymbols + len / esize) *
+			sizeof(*symbols));
+		if (symbols == NULL) {
+			fprintf(stderr, "faultdecode: out of memory\n");
+			exit(2);
+		}
+		for (j = 0; j < len / esize; j++) {
+			sym = elf + off + (uint64_t)j * esize;
+			name = get(sym, 4);
+			if (((wide ? sym[4] : sym[12]) & 0xF) != STT_FUNC ||
+				name >= strsz)
+				continue;
+			symbols[nsymbols].addr = wide ? get(sym + 8, 8) :
+				get(sym + 4, 4);
+			symbols[nsymbols].size = wide ? get(sym + 16, 8) :
+				get(sym + 8, 4);
+			if (thumb)
+				symbols[nsymbols].addr &= ~(uint64_t)1;
+			symbols[nsymbols].name = (const char *)elf + strtab +
+				name;
+			if (symbols[nsymbols].size > 0)
+				nsymbols++;
+		}
+	}
+
+	return 0;
+}
+
+/* Function and offset of a code address. Return addresses (lr and the
+ * trace) carry the Thumb bit, it is cleared before the lookup like on ARM
+ * for any address.
+ */
+static void print_addr(const char *label, uint64_t addr, int ret) {
+	unsigned i;
+
+	printf("    %-6s 0x%08llx", label, (unsigned long long)addr);
+	if (thumb || ret)
+		addr &= ~(uint64_t)1;
+	for (i = 0; i < nsymbols; i++) {
+		if (addr >= symbols[i].addr &&
+			addr - symbols[i].addr < symbols[i].size) {
+			printf(" %s+0x%llx\n", symbols[i].name,
+				(unsigned long long)(addr - symbols[i].addr));
+			return;
+		}
+	}
+	printf(" ?\n");
+}
+
+static void print_bits(const char *label, uint64_t value,
+	const struct bit *bits, unsigned n) {
+	unsigned i;
+
+	printf("    %-6s 0x%08llx", label, (unsigned long long)value);
+	for (i = 0; i < n; i++)
+		if (value & (1ULL << bits[i].bit))
+			printf(" %s", bits[i].name);
+	printf("\n");
+}
+
+static unsigned split(char *line, char *tok[], unsigned max) {
+	unsigned n = 0;
+	char *p = line;
+
+	while (n < max) {
+		while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n')
+			p++;
+		if (*p == '\0')
+			break;
+		tok[n++] = p;
+		while (*p != '\0' && *p != ' ' && *p != '\t' && *p != '\r' &&
+			*p != '\n')
+			p++;
+		if (*p != '\0')
+			*p++ = '\0';
+	}
+
+	return n;
+}
+
+/* The annotations of one "fault:" line */
+static void decode(char *line) {
+	char *tok[FAULTDECODE_TOKENS];
+	unsigned n = split(line, tok, FAULTDECODE_TOKENS), i;
+	unsigned long exception;
+	uint64_t value;
+
+	for (i = 0; i + 1 < n; i += 2) {
+		value = strtoull(tok[i + 1], NULL, 0);
+		if (strcmp(tok[i], "exception") == 0) {
+			exception = (unsigned long)value;
+			if (exception >= 16)
+				printf("    IRQ %lu\n", exception - 16);
+			else if (exception_names[exception] != NULL)
+				printf("    %s\n", exception_names[exception]);
+		} else if (strcmp(tok[i], "pc") == 0) {
+			print_addr(tok[i], value, 0);
+		} else if (strcmp(tok[i], "lr") == 0) {
+			print_addr(tok[i], value, 1);
+		} else if (strcmp(tok[i], "cfsr") == 0) {
+			print_bits(tok[i], value, cfsr_bits,
+				sizeof(cfsr_bits) / sizeof(cfsr_bits[0]));
+		} else if (strcmp(tok[i], "hfsr") == 0) {
+			print_bits(tok[i], value, hfsr_bits,
+				sizeof(hfsr_bits) / sizeof(hfsr_bits[0]));
+		} else if (strcmp(tok[i], "trace") == 0) {
+			/* every address after it */
+			for (i++; i < n; i++)
+				print_addr("trace", strtoull(tok[i], NULL, 0),
+					1);
+		}
+	}
+}
+
+int main(int argc, char *argv[]) {
+	char line[FAULTDECODE_LINE], *start;
+	unsigned reports = 0;
+	size_t elf_size;
+	uint8_t *elf;
+	FILE *in = stdin;
+
+	if (argc != 2 && argc != 3) {
+		fprintf(stderr, "Use: %s <ELF file> [console output]\n", argv[0]);
+		return 2;
+	}
+
+	if ((elf = load(argv[1], &elf_size)) == NULL)
+		return 1;
+	if (parse_symbols(elf, elf_size)) {
+		fprintf(stderr, "%s: not a little endian ELF file\n", argv[1]);
+		return 1;
+	}
+	if (argc == 3 && (in = fopen(argv[2], "r")) == NULL) {
+		perror(argv[2]);
+		return 1;
+	}
+
+	while (fgets(line, sizeof(line), in) != NULL) {
+		if ((start = strstr(line, "fault: ")) == NULL)
+			continue;
+		fputs(start, stdout);
+		if (strncmp(start, "fault: exception ", 17) == 0)
+			reports++;
+		decode(start + 7);
+	}
+	if (in != stdin)
+		fclose(in);
+
+	if (reports == 0)
+		printf("faultdecode: no crash report\n");
+
+	return 0;
+}
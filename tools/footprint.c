@@ -0,0 +1,678 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file footprint.c
+ * @brief Flash and RAM usage of an executable from its ELF and map files
+ *
+ * Allocated sections count as flash when their contents are stored in the
+ * image and as RAM when they are writable, so .data counts as both, .bss,
+ * .heap and .stack as RAM only. Input sections of the GNU ld map file give
+ * the module (object file or library) of every byte, the ELF symbol table
+ * gives the symbols.
+ *
+ * Use: footprint [-n top] [-b baseline] [-s save] [-l budgets] <ELF> <map>
+ *
+ *	-n top - number of symbols to list, 20 by default
+ *	-b baseline - print the differences to a file written by -s
+ *	-s save - write the usage of every section, module and symbol
+ *	-l budgets - check the usage against the limits in this file
+ *
+ * Baseline records are "<kind> <module> <name> <flash> <ram>", kind being
+ * total, section, module or symbol. Budget lines are
+ * "<kind> <name> <flash|ram> <bytes>", where name "*" applies to every
+ * section, module or symbol and is "-" for total, "#" starts a comment.
+ * The exit status is 1 when a budget is exceeded.
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SHT_SYMTAB (2)
+#define SHT_NOBITS (8)
+#define SHF_WRITE (0x1)
+#define SHF_ALLOC (0x2)
+#define STT_OBJECT (1)
+#define STT_FUNC (2)
+#define EM_ARM (40)
+
+#define FOOTPRINT_TOP (20)
+#define FOOTPRINT_NAME (128)
+
+enum kind { TOTAL, SECTION, MODULE, SYMBOL, KINDS };
+
+static const char *const kind_names[KINDS] = {
+	"total", "section", "module", "symbol",
+};
+
+/* Usage of one section, module or symbol, and of it in the baseline */
+struct item {
+	char module[FOOTPRINT_NAME];
+	char name[FOOTPRINT_NAME];
+	uint64_t flash, ram;
+	uint64_t base_flash, base_ram;
+	int in_base;
+};
+
+struct list {
+	struct item *items;
+	unsigned count;
+	unsigned size;
+};
+
+struct section {
+	char name[FOOTPRINT_NAME];
+	uint64_t addr;
+	uint64_t size;
+	int flash, ram;
+};
+
+/* Address range of an input section from the map file */
+struct range {
+	uint64_t addr;
+	uint64_t size;
+	unsigned module;
+};
+
+static struct list lists[KINDS];
+static struct section *sections;
+static unsigned nsections;
+static struct range *ranges;
+static unsigned nranges, ranges_size;
+
+static uint64_t get(const uint8_t *p, unsigned size) {
+	uint64_t value = 0;
+
+	while (size--)
+		value = value << 8 | p[size];
+
+	return value;
+}
+
+static void *grow(void *ptr, unsigned *size, unsigned count, size_t elem) {
+
+	if (count < *size)
+		return ptr;
+	*size = *size ? 2 * *size : 64;
+	if ((ptr = realloc(ptr, *size * elem)) == NULL) {
+		fprintf(stderr, "footprint: out of memory\n");
+		exit(2);
+	}
+
+	return ptr;
+}
+
+static void copy(char *dst, const char *src) {
+
+	strncpy(dst, src, FOOTPRINT_NAME - 1);
+	dst[FOOTPRINT_NAME - 1] = '\0';
+}
+
+/* Item of a list, added if it is not there yet */
+static struct item *item(enum kind kind, const char *module,
+	const char *name) {
+	struct list *l = &lists[kind];
+	unsigned i;
+
+	for (i = 0; i < l->count; i++)
+		if (strcmp(l->items[i].name, name) == 0 &&
+			strcmp(l->items[i].module, module) == 0)
+			return &l->items[i];
+
+	l->items = grow(l->items, &l->size, l->count, sizeof(struct item));
+	memset(&l->items[l->count], 0, sizeof(struct item));
+	copy(l->items[l->count].module, module);
+	copy(l->items[l->count].name, name);
+
+	return &l->items[l->count++];
+}
+
+static uint8_t *load(const char *name, size_t *size) {
+	uint8_t *buf;
+	FILE *in;
+	long len;
+
+	if ((in = fopen(name, "rb")) == NULL) {
+		perror(name);
+		return NULL;
+	}
+	fseek(in, 0, SEEK_END);
+	len = ftell(in);
+	fseek(in, 0, SEEK_SET);
+	buf = malloc(len > 0 ? len + 1 : 1);
+	if (buf != NULL && fread(buf, 1, len, in) != (size_t)len) {
+		free(buf);
+		buf = NULL;
+	}
+	fclose(in);
+	if (buf == NULL) {
+		fprintf(stderr, "%s: can not read\n", name);
+		return NULL;
+	}
+	buf[len] = '\0';
+	*size = len;
+
+	return buf;
+}
+
+static struct section *section_by_name(const char *name) {
+	unsigned i;
+
+	for (i = 0; i < nsections; i++)
+		if (strcmp(sections[i].name, name) == 0)
+			return &sections[i];
+
+	return NULL;
+}
+
+static struct section *section_by_addr(uint64_t addr) {
+	unsigned i;
+
+	for (i = 0; i < nsections; i++)
+		if (addr >= sections[i].addr &&
+			addr - sections[i].addr < sections[i].size)
+			return &sections[i];
+
+	return NULL;
+}
+
+/* Module of an input file: memory for build/HOST/debug/src/memory.o,
+ * libc.a for one of its members
+ */
+static void module_name(const char *file, char *out) {
+	const char *base = strrchr(file, '/');
+	char *p;
+
+	copy(out, base ? base + 1 : file);
+	if (strstr(out, ".ltrans") != NULL) {
+		copy(out, "(lto)");
+	} else if ((p = strchr(out, '(')) != NULL) {
+		*p = '\0';
+	} else if ((p = strrchr(out, '.')) != NULL && strcmp(p, ".o") == 0) {
+		*p = '\0';
+	}
+}
+
+/* Splits a line into at most max blank separated tokens */
+static unsigned split(char *line, char *tok[], unsigned max) {
+	unsigned n = 0;
+
+	while (n < max) {
+		while (*line == ' ' || *line == '\t' || *line == '\r')
+			*line++ = '\0';
+		if (*line == '\0')
+			break;
+		tok[n++] = line;
+		while (*line && *line != ' ' && *line != '\t' && *line != '\r')
+			line++;
+	}
+	if (*line)
+		*line = '\0';
+
+	return n;
+}
+
+/* Sections that the linker makes up, listed under the first input file */
+static int synthetic(const char *name) {
+	static const char *const prefixes[] = {
+		".interp", ".dyn", ".rela", ".rel.", ".gnu.hash", ".gnu.version",
+		".hash", ".plt", ".got", ".eh_frame_hdr", ".note.gnu.build-id",
+	};
+	unsigned i;
+
+	for (i = 0; i < sizeof(prefixes) / sizeof(prefixes[0]); i++)
+		if (strncmp(name, prefixes[i], strlen(prefixes[i])) == 0)
+			return 1;
+
+	return 0;
+}
+
+static int range_cmp(const void *a, const void *b) {
+	const struct range *x = a, *y = b;
+
+	return (x->addr > y->addr) - (x->addr < y->addr);
+}
+
+static const char *module_by_addr(uint64_t addr) {
+	unsigned lo = 0, hi = nranges, mid;
+
+	while (lo < hi) {
+		mid = (lo + hi) / 2;
+		if (ranges[mid].addr + ranges[mid].size <= addr)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo < nranges && ranges[lo].addr <= addr)
+		return lists[MODULE].items[ranges[lo].module].name;
+
+	return "(other)";
+}
+
+/* Allocated sections and their totals */
+static int parse_sections(const uint8_t *elf, size_t size) {
+	unsigned wide, shentsize, shnum, shstrndx, i;
+	uint64_t shoff, flags, type, strtab, name;
+	const uint8_t *sh;
+	struct section *s;
+	struct item *it;
+
+	if (size < 0x40 || memcmp(elf, "\177ELF", 4) != 0 || elf[5] != 1)
+		return -1;
+	wide = elf[4] == 2;
+	shoff = wide ? get(elf + 0x28, 8) : get(elf + 0x20, 4);
+	shentsize = get(elf + (wide ? 0x3A : 0x2E), 2);
+	shnum = get(elf + (wide ? 0x3C : 0x30), 2);
+	shstrndx = get(elf + (wide ? 0x3E : 0x32), 2);
+	if (shstrndx >= shnum || shoff + (uint64_t)shentsize * shnum > size)
+		return -1;
+	sh = elf + shoff + (uint64_t)shstrndx * shentsize;
+	strtab = wide ? get(sh + 0x18, 8) : get(sh + 0x10, 4);
+
+	sections = calloc(shnum, sizeof(*sections));
+	if (sections == NULL)
+		return -1;
+	for (i = 0; i < shnum; i++) {
+		sh = elf + shoff + (uint64_t)i * shentsize;
+		flags = get(sh + 8, wide ? 8 : 4);
+		type = get(sh + 4, 4);
+		name = strtab + get(sh, 4);
+		if (!(flags & SHF_ALLOC) || name >= size)
+			continue;
+
+		s = &sections[nsections++];
+		copy(s->name, (const char *)elf + name);
+		s->addr = wide ? get(sh + 0x10, 8) : get(sh + 0x0C, 4);
+		s->size = wide ? get(sh + 0x20, 8) : get(sh + 0x14, 4);
+		s->flash = type != SHT_NOBITS;
+		s->ram = (flags & SHF_WRITE) != 0;
+
+		it = item(SECTION, "-", s->name);
+		it->flash = s->flash ? s->size : 0;
+		it->ram = s->ram ? s->size : 0;
+		it = item(TOTAL, "-", "-");
+		it->flash += s->flash ? s->size : 0;
+		it->ram += s->ram ? s->size : 0;
+	}
+
+	return 0;
+}
+
+/* Symbols with a size in allocated sections */
+static void parse_symbols(const uint8_t *elf, size_t size) {
+	unsigned wide = elf[4] == 2, shentsize, shnum, i, j, esize, info;
+	uint64_t shoff, off, len, link, strtab, strsz, name, value, symsize;
+	int thumb = get(elf + 0x12, 2) == EM_ARM;
+	const uint8_t *sh, *sym;
+	struct section *s;
+	struct item *it;
+
+	shoff = wide ? get(elf + 0x28, 8) : get(elf + 0x20, 4);
+	shentsize = get(elf + (wide ? 0x3A : 0x2E), 2);
+	shnum = get(elf + (wide ? 0x3C : 0x30), 2);
+	esize = wide ? 24 : 16;
+
+	for (i = 0; i < shnum; i++) {
+		sh = elf + shoff + (uint64_t)i * shentsize;
+		if (get(sh + 4, 4) != SHT_SYMTAB)
+			continue;
+		off = wide ? get(sh + 0x18, 8) : get(sh + 0x10, 4);
+		len = wide ? get(sh + 0x20, 8) : get(sh + 0x14, 4);
+		link = get(sh + (wide ? 0x28 : 0x18), 4);
+		if (off + len > size || link >= shnum)
+			continue;
+		sh = elf + shoff + link * shentsize;
+		strtab = wide ? get(sh + 0x18, 8) : get(sh + 0x10, 4);
+		strsz = wide ? get(sh + 0x20, 8) : get(sh + 0x14, 4);
+		if (strtab + strsz > size)
+			continue;
+
+		for (j = 0; j < len / esize; j++) {
+			sym = elf + off + (uint64_t)j * esize;
+			name = get(sym, 4);
+			value = wide ? get(sym + 8, 8) : get(sym + 4, 4);
+			symsize = wide ? get(sym + 16, 8) : get(sym + 8, 4);
+			info = wide ? sym[4] : sym[12];
+			if (((info & 0xF) != STT_OBJECT && (info & 0xF) != STT_FUNC) ||
+				symsize == 0 || name >= strsz)
+				continue;
+			if (thumb && (info & 0xF) == STT_FUNC)
+				value &= ~(uint64_t)1;
+			if ((s = section_by_addr(value)) == NULL)
+				continue;
+
+			it = item(SYMBOL, module_by_addr(value),
+				(const char *)elf + strtab + name);
+			it->flash += s->flash ? symsize : 0;
+			it->ram += s->ram ? symsize : 0;
+		}
+	}
+}
+
+/* Input sections of the map file, attributed to their modules */
+static void parse_map(char *map) {
+	char *line, *next, *tok[4];
+	char module[FOOTPRINT_NAME];
+	struct section *out = NULL;
+	uint64_t addr, size;
+	struct item *it;
+	unsigned n;
+
+	if ((line = strstr(map, "Linker script and memory map")) == NULL)
+		return;
+
+	for (; line != NULL && *line; line = next) {
+		if ((next = strchr(line, '\n')) != NULL)
+			*next++ = '\0';
+
+		/* output section */
+		if (*line != ' ') {
+			if (*line == '.' || isalpha((unsigned char)*line))
+				out = split(line, tok, 1) ? section_by_name(tok[0]) : NULL;
+			continue;
+		}
+		/* input section: " name [addr size file]", the name alone
+		 * on its line when it is long
+		 */
+		if (line[1] == ' ' || line[1] == '*' || out == NULL)
+			continue;
+		n = split(line, tok, 4);
+		if (n == 1 && next != NULL && strncmp(next, "    ", 4) == 0) {
+			line = next;
+			if ((next = strchr(line, '\n')) != NULL)
+				*next++ = '\0';
+			n += split(line, tok + 1, 3);
+		}
+		if (n < 4 || strncmp(tok[1], "0x", 2) != 0)
+			continue;
+		addr = strtoull(tok[1], NULL, 16);
+		size = strtoull(tok[2], NULL, 16);
+		if (size == 0)
+			continue;
+
+		if (synthetic(tok[0]))
+			copy(module, "(linker)");
+		else
+			module_name(tok[3], module);
+		it = item(MODULE, "-", module);
+		it->flash += out->flash ? size : 0;
+		it->ram += out->ram ? size : 0;
+
+		ranges = grow(ranges, &ranges_size, nranges, sizeof(*ranges));
+		ranges[nranges].addr = addr;
+		ranges[nranges].size = size;
+		ranges[nranges].module = it - lists[MODULE].items;
+		nranges++;
+	}
+	qsort(ranges, nranges, sizeof(*ranges), range_cmp);
+}
+
+/* Padding and whatever the map does not attribute */
+static void add_other(void) {
+	struct item *total = item(TOTAL, "-", "-"), *other;
+	uint64_t flash = 0, ram = 0;
+	unsigned i;
+
+	for (i = 0; i < lists[MODULE].count; i++) {
+		flash += lists[MODULE].items[i].flash;
+		ram += lists[MODULE].items[i].ram;
+	}
+	other = item(MODULE, "-", "(other)");
+	other->flash = total->flash > flash ? total->flash - flash : 0;
+	other->ram = total->ram > ram ? total->ram - ram : 0;
+}
+
+static int load_baseline(const char *name) {
+	char kind[16], module[FOOTPRINT_NAME], sym[FOOTPRINT_NAME];
+	unsigned long long flash, ram;
+	struct item *it;
+	FILE *in;
+	int k;
+
+	if ((in = fopen(name, "r")) == NULL) {
+		perror(name);
+		return -1;
+	}
+	while (fscanf(in, "%15s %127s %127s %llu %llu", kind, module, sym,
+		&flash, &ram) == 5) {
+		for (k = 0; k < KINDS; k++)
+			if (strcmp(kind, kind_names[k]) == 0)
+				break;
+		if (k == KINDS)
+			continue;
+		it = item(k, module, sym);
+		it->base_flash = flash;
+		it->base_ram = ram;
+		it->in_base = 1;
+	}
+	fclose(in);
+
+	return 0;
+}
+
+static int save_baseline(const char *name) {
+	FILE *out = fopen(name, "w");
+	struct item *it;
+	unsigned k, i;
+
+	if (out == NULL) {
+		perror(name);
+		return -1;
+	}
+	for (k = 0; k < KINDS; k++) {
+		for (i = 0; i < lists[k].count; i++) {
+			it = &lists[k].items[i];
+			if (it->flash == 0 && it->ram == 0)
+				continue;
+			fprintf(out, "%s %s %s %llu %llu\n", kind_names[k],
+				it->module, it->name, (unsigned long long)it->flash,
+				(unsigned long long)it->ram);
+		}
+	}
+	fclose(out);
+
+	return 0;
+}
+
+static int item_cmp(const void *a, const void *b) {
+	const struct item *x = a, *y = b;
+	uint64_t sx = x->flash + x->ram, sy = y->flash + y->ram;
+
+	return (sx < sy) - (sx > sy);
+}
+
+static int delta_cmp(const void *a, const void *b) {
+	const struct item *x = a, *y = b;
+	int64_t dx = (int64_t)(x->flash + x->ram - x->base_flash - x->base_ram);
+	int64_t dy = (int64_t)(y->flash + y->ram - y->base_flash - y->base_ram);
+
+	dx = dx < 0 ? -dx : dx;
+	dy = dy < 0 ? -dy : dy;
+
+	return (dx < dy) - (dx > dy);
+}
+
+static void print_item(const struct item *it, int baseline, int module) {
+
+	printf("  %-32s", it->name);
+	if (module)
+		printf(" %-12s", it->module);
+	printf(" %9llu %9llu", (unsigned long long)it->flash,
+		(unsigned long long)it->ram);
+	if (baseline && it->in_base)
+		printf(" %+9lld %+9lld",
+			(long long)(it->flash - it->base_flash),
+			(long long)(it->ram - it->base_ram));
+	else if (baseline)
+		printf(" %9s %9s", "new", "new");
+	printf("\n");
+}
+
+static void print_header(const char *title, int baseline, int module) {
+
+	printf("%s\n  %-32s", title, "");
+	if (module)
+		printf(" %-12s", "module");
+	printf(" %9s %9s", "flash", "ram");
+	if (baseline)
+		printf(" %9s %9s", "+flash", "+ram");
+	printf("\n");
+}
+
+static void print_list(enum kind kind, const char *title, unsigned top,
+	int baseline) {
+	struct list *l = &lists[kind];
+	unsigned i, shown = 0, gone = 0;
+
+	qsort(l->items, l->count, sizeof(struct item), item_cmp);
+	print_header(title, baseline, kind == SYMBOL);
+	for (i = 0; i < l->count && shown < top; i++) {
+		if (l->items[i].flash == 0 && l->items[i].ram == 0)
+			continue;
+		print_item(&l->items[i], baseline, kind == SYMBOL);
+		shown++;
+	}
+	for (i = 0; i < l->count; i++)
+		gone += l->items[i].flash == 0 && l->items[i].ram == 0 &&
+			l->items[i].in_base;
+	if (baseline && gone)
+		printf("  %u gone since the baseline\n", gone);
+}
+
+static void print_changes(unsigned top) {
+	struct list *l = &lists[SYMBOL];
+	unsigned i, shown = 0;
+
+	qsort(l->items, l->count, sizeof(struct item), delta_cmp);
+	print_header("Changed symbols:", 1, 1);
+	for (i = 0; i < l->count && shown < top; i++) {
+		if (l->items[i].flash == l->items[i].base_flash &&
+			l->items[i].ram == l->items[i].base_ram)
+			continue;
+		print_item(&l->items[i], 1, 1);
+		shown++;
+	}
+}
+
+/* Returns the number of exceeded budgets */
+static unsigned check_budgets(const char *name) {
+	char kind[16], what[FOOTPRINT_NAME], region[8];
+	unsigned long long limit;
+	unsigned exceeded = 0, i;
+	struct item *it;
+	uint64_t used;
+	char line[256];
+	FILE *in;
+	int k;
+
+	if ((in = fopen(name, "r")) == NULL) {
+		perror(name);
+		return 1;
+	}
+	while (fgets(line, sizeof(line), in) != NULL) {
+		if (sscanf(line, "%15s %127s %7s %llu", kind, what, region,
+			&limit) != 4 || kind[0] == '#')
+			continue;
+		for (k = 0; k < KINDS; k++)
+			if (strcmp(kind, kind_names[k]) == 0)
+				break;
+		if (k == KINDS || (strcmp(region, "flash") != 0 &&
+			strcmp(region, "ram") != 0)) {
+			fprintf(stderr, "%s: bad budget: %s", name, line);
+			exceeded++;
+			continue;
+		}
+
+		for (i = 0; i < lists[k].count; i++) {
+			it = &lists[k].items[i];
+			if (strcmp(what, "*") != 0 && strcmp(what, it->name) != 0)
+				continue;
+			used = region[0] == 'f' ? it->flash : it->ram;
+			if (used <= limit)
+				continue;
+			printf("footprint: %s %s uses %llu bytes of %s, budget %llu\n",
+				kind_names[k], it->name, (unsigned long long)used,
+				region, limit);
+			exceeded++;
+		}
+	}
+	fclose(in);
+
+	return exceeded;
+}
+
+int main(int argc, char *argv[]) {
+	const char *baseline = NULL, *save = NULL, *budgets = NULL;
+	unsigned top = FOOTPRINT_TOP, exceeded = 0;
+	struct item *total;
+	size_t elf_size, map_size;
+	uint8_t *elf;
+	char *map;
+	int i;
+
+	for (i = 1; i + 1 < argc && argv[i][0] == '-'; i += 2) {
+		if (strcmp(argv[i], "-n") == 0)
+			top = strtoul(argv[i + 1], NULL, 10);
+		else if (strcmp(argv[i], "-b") == 0)
+			baseline = argv[i + 1];
+		else if (strcmp(argv[i], "-s") == 0)
+			save = argv[i + 1];
+		else if (strcmp(argv[i], "-l") == 0)
+			budgets = argv[i + 1];
+		else
+			break;
+	}
+	if (argc - i != 2) {
+		fprintf(stderr, "Use: %s [-n top] [-b baseline] [-s save] "
+			"[-l budgets] <ELF> <map>\n", argv[0]);
+		return 2;
+	}
+
+	if ((elf = load(argv[i], &elf_size)) == NULL ||
+		(map = (char *)load(argv[i + 1], &map_size)) == NULL)
+		return 2;
+	if (parse_sections(elf, elf_size)) {
+		fprintf(stderr, "%s: not a little endian ELF file\n", argv[i]);
+		return 2;
+	}
+	parse_map(map);
+	add_other();
+	parse_symbols(elf, elf_size);
+	if (baseline != NULL && load_baseline(baseline))
+		return 2;
+
+	total = item(TOTAL, "-", "-");
+	printf("footprint: %s\n", argv[i]);
+	printf("  %-32s %9llu %9llu", "total",
+		(unsigned long long)total->flash, (unsigned long long)total->ram);
+	if (baseline != NULL)
+		printf(" %+9lld %+9lld",
+			(long long)(total->flash - total->base_flash),
+			(long long)(total->ram - total->base_ram));
+	printf("\n");
+	print_list(SECTION, "Sections:", (unsigned)-1, baseline != NULL);
+	print_list(MODULE, "Modules:", (unsigned)-1, baseline != NULL);
+	print_list(SYMBOL, "Largest symbols:", top, baseline != NULL);
+	if (baseline != NULL)
+		print_changes(top);
+
+	if (save != NULL && save_baseline(save))
+		return 2;
+	if (budgets != NULL)
+		exceeded = check_budgets(budgets);
+
+	return exceeded ? 1 : 0;
+}
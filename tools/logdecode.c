@@ -0,0 +1,221 @@
+/******************************************************************************
+ * Copyright (C) 2017 by Alex Fosdick - University of Colorado
+ *
+ * Redistribution, modification or use of this software in source or binary
+ * forms is permitted as long as the files maintain this copyright. Users are
+ * permitted to modify this and use it to learn about the field of embedded
+ * software. Alex Fosdick and the University of Colorado are not liable for any
+ * misuse of this material.
+ *
+ *****************************************************************************/
+/**
+ * @file logdecode.c
+ * @brief Host decoder for DEFERRED_LOG binary logs
+ *
+ * Loads the allocated sections and the address of logbuf_put() from the
+ * ELF file (32 or 64 bit, little endian) that produced the log, then
+ * replays every record through logbuf_format().
+ *
+ * Use: logdecode <ELF file> <binary log>
+ *
+ * @author Valentina Krasnobaeva
+ * @date October 18 2026
+ *
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "logbuf.h"
+
+#define SHT_PROGBITS (1)
+#define SHT_SYMTAB (2)
+#define SHF_ALLOC (0x2)
+
+struct section {
+	uint64_t addr;
+	uint64_t size;
+	const uint8_t *data;
+};
+
+static uint8_t *elf;
+static size_t elf_size;
+static struct section *sections;
+static unsigned nsections;
+static uint64_t bias;
+
+static uint64_t get(const uint8_t *p, unsigned size) {
+	uint64_t value = 0;
+
+	while (size--)
+		value = value << 8 | p[size];
+
+	return value;
+}
+
+static uint8_t *load(const char *name, size_t *size) {
+	uint8_t *buf;
+	FILE *in;
+	long len;
+
+	if ((in = fopen(name, "rb")) == NULL) {
+		perror(name);
+		return NULL;
+	}
+	fseek(in, 0, SEEK_END);
+	len = ftell(in);
+	fseek(in, 0, SEEK_SET);
+	buf = malloc(len > 0 ? len : 1);
+	if (buf != NULL && fread(buf, 1, len, in) != (size_t)len) {
+		free(buf);
+		buf = NULL;
+	}
+	fclose(in);
+	if (buf == NULL)
+		fprintf(stderr, "%s: can not read\n", name);
+	*size = len;
+
+	return buf;
+}
+
+/* Sections and the logbuf_put() symbol, returns the pointer size or 0 */
+static unsigned parse_elf(uint64_t *logbuf_put_addr) {
+	unsigned wide, shentsize, shnum, i, j;
+	uint64_t shoff, off, size, link, symoff, strsz, name;
+	const uint8_t *sh, *sym, *strtab;
+
+	if (elf_size < 0x40 || memcmp(elf, "\177ELF", 4) != 0 || elf[5] != 1)
+		return 0;
+	wide = elf[4] == 2;
+	shoff = wide ? get(elf + 0x28, 8) : get(elf + 0x20, 4);
+	shentsize = get(elf + (wide ? 0x3A : 0x2E), 2);
+	shnum = get(elf + (wide ? 0x3C : 0x30), 2);
+	if (shoff + (uint64_t)shentsize * shnum > elf_size)
+		return 0;
+
+	sections = calloc(shnum, sizeof(*sections));
+	if (sections == NULL)
+		return 0;
+
+	*logbuf_put_addr = 0;
+	for (i = 0; i < shnum; i++) {
+		sh = elf + shoff + (uint64_t)i * shentsize;
+		off = wide ? get(sh + 0x18, 8) : get(sh + 0x10, 4);
+		size = wide ? get(sh + 0x20, 8) : get(sh + 0x14, 4);
+		if (off + size > elf_size)
+			continue;
+
+		if (get(sh + 4, 4) == SHT_PROGBITS &&
+			(get(sh + 8, wide ? 8 : 4) & SHF_ALLOC)) {
+			sections[nsections].addr = wide ? get(sh + 0x10, 8) :
+				get(sh + 0x0C, 4);
+			sections[nsections].size = size;
+			sections[nsections].data = elf + off;
+			nsections++;
+		}
+
+		if (get(sh + 4, 4) != SHT_SYMTAB)
+			continue;
+		link = get(sh + (wide ? 0x28 : 0x18), 4);
+		if (link >= shnum)
+			continue;
+		symoff = off;
+		off = shoff + link * shentsize;
+		strtab = elf + (wide ? get(elf + off + 0x18, 8) :
+			get(elf + off + 0x10, 4));
+		strsz = wide ? get(elf + off + 0x20, 8) : get(elf + off + 0x14, 4);
+		if ((uint64_t)(strtab - elf) + strsz > elf_size)
+			continue;
+
+		for (j = 0; j < size / (wide ? 24 : 16); j++) {
+			sym = elf + symoff + j * (wide ? 24 : 16);
+			name = get(sym, 4);
+			if (name < strsz && strncmp((const char *)strtab + name,
+				"logbuf_put", strsz - name) == 0)
+				*logbuf_put_addr = wide ? get(sym + 8, 8) :
+					get(sym + 4, 4);
+		}
+	}
+
+	return wide ? 8 : 4;
+}
+
+/* Address in the producing process to a string inside the ELF file */
+static const char *string(uint64_t addr) {
+	unsigned i;
+
+	addr -= bias;
+	for (i = 0; i < nsections; i++) {
+		if (addr < sections[i].addr ||
+			addr - sections[i].addr >= sections[i].size)
+			continue;
+		if (memchr(sections[i].data + (addr - sections[i].addr), '\0',
+			sections[i].size - (addr - sections[i].addr)) == NULL)
+			return NULL;
+		return (const char *)sections[i].data + (addr - sections[i].addr);
+	}
+
+	return NULL;
+}
+
+int main(int argc, char *argv[]) {
+	struct logbuf_record rec;
+	uint64_t logbuf_put_addr, fmt;
+	uint32_t expect = 1, nwords;
+	unsigned ptr_size;
+	size_t log_size, pos, header;
+	uint8_t *log;
+	char text[1024];
+	const char *str;
+
+	if (argc != 3) {
+		fprintf(stderr, "Use: %s <ELF file> <binary log>\n", argv[0]);
+		return 2;
+	}
+
+	if ((elf = load(argv[1], &elf_size)) == NULL ||
+		(log = load(argv[2], &log_size)) == NULL)
+		return 1;
+	if ((ptr_size = parse_elf(&logbuf_put_addr)) == 0) {
+		fprintf(stderr, "%s: not a little endian ELF file\n", argv[1]);
+		return 1;
+	}
+
+	header = 2 * sizeof(uint32_t) + ptr_size;
+	for (pos = 0; pos + header <= log_size; ) {
+		rec.seq = get(log + pos, 4);
+		nwords = get(log + pos + 4, 4);
+		fmt = get(log + pos + 8, ptr_size);
+		pos += header;
+		if (pos + (size_t)nwords * 4 > log_size || nwords > LOGBUF_MAX_WORDS)
+			break;
+
+		rec.nwords = nwords;
+		memcpy(rec.words, log + pos, (size_t)nwords * 4);
+		pos += (size_t)nwords * 4;
+
+		/* relocation marker */
+		if (rec.seq == 0) {
+			bias = fmt - logbuf_put_addr;
+			continue;
+		}
+
+		if (rec.seq != expect)
+			printf("logdecode: %u records lost\n", rec.seq - expect);
+		expect = rec.seq + 1;
+
+		if ((str = string(fmt)) == NULL) {
+			printf("logdecode: record %u: unknown format at 0x%llx\n",
+				rec.seq, (unsigned long long)fmt);
+			continue;
+		}
+		logbuf_format(text, sizeof(text), str, &rec, ptr_size, string);
+		fputs(text, stdout);
+	}
+
+	if (pos != log_size)
+		fprintf(stderr, "%s: truncated record at %lu\n", argv[2],
+			(unsigned long)pos);
+
+	return 0;
+}